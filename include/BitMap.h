@@ -17,7 +17,8 @@
 #ifndef BITMAP_H_
 #define BITMAP_H_
 
-#include <bitset>
+#include <cstdint>
+#include <vector>
 
 #include "Attribute.h"
 #include "Callbackable.h"
@@ -26,8 +27,14 @@
 class SqlDB;
 
 /**
- *  This class represents a generic BitMap
+ *  This class represents a generic BitMap. Bits are packed in 64-bit words and
+ *  a summary level (one bit per word, set when the word has no free bits) is
+ *  used to find the first free bit.
  *
+ *  The bitmap is stored in the DB as a compressed '0'/'1' string. The
+ *  compressed string of the last load or write is kept, so a bitmap can be
+ *  reused across operations: select() only decodes the map if it changed in
+ *  the DB and update() only writes the map if it was modified.
  */
 template <unsigned int N>
 class BitMap : public Callbackable
@@ -38,7 +45,7 @@ public:
      *  that MUST exists during the object lifetime.
      */
     BitMap(const VectorAttribute& bs_conf, int _id, const char * _db_table)
-        : id(_id), start_bit(0), bs(0), db_table(_db_table)
+        : id(_id), start_bit(0), reserved_bit(WORDS, 0), db_table(_db_table)
     {
         std::string reserved;
 
@@ -49,17 +56,18 @@ public:
         {
             set_reserved_bit(reserved);
         }
+
+        init_blocked();
     };
 
     BitMap(int _id, const char * _db_table)
-        : id(_id), start_bit(0), bs(0), db_table(_db_table)
-    {};
-
-    virtual ~BitMap()
+        : id(_id), start_bit(0), reserved_bit(WORDS, 0), db_table(_db_table)
     {
-        delete bs;
+        init_blocked();
     };
 
+    virtual ~BitMap() = default;
+
     /* ---------------------------------------------------------------------- */
     /* Database interface                                                     */
     /* ---------------------------------------------------------------------- */
@@ -84,35 +92,70 @@ public:
     int insert(int _id, SqlDB * db)
     {
         id = _id;
-        bs = new std::bitset<N>;
+
+        bs.assign(WORDS, 0);
+
+        init_summary();
 
         return insert_replace(db, false);
     }
 
     /**
-     *  Loads a bitmap from its string representation. This function is called
-     *  once to load the bitmap from the DB.
+     *  Loads a bitmap from its string representation. The map is only decoded
+     *  if it differs from the last one loaded or written by this object.
      *    @param id of the set, this will update the id of the bitmap
      *    @return 0 on success
      */
     int select(int _id, SqlDB * db)
     {
+        std::string zbs;
         std::string uzbs;
 
+        if ( _id != id )
+        {
+            zbs_cache.clear();
+        }
+
         id = _id;
 
-        if ( select(db, uzbs) != 0 )
+        if ( select(db, zbs) != 0 )
+        {
+            return -1;
+        }
+
+        if ( !bs.empty() && zbs == zbs_cache )
+        {
+            dirty = false;
+            return 0;
+        }
+
+        if ( ssl_util::zlib_decompress64(zbs, uzbs) != 0 )
+        {
+            return -1;
+        }
+
+        if ( from_string(uzbs) != 0 )
         {
             return -1;
         }
 
-        bs = new std::bitset<N>(uzbs);
+        zbs_cache = std::move(zbs);
+        dirty     = false;
 
         return 0;
     }
 
+    /**
+     *  Writes the bitmap to the DB, if it has been modified
+     *    @return 0 on success
+     */
     int update(SqlDB * db)
     {
+        if ( !dirty )
+        {
+            return 0;
+        }
+
         return insert_replace(db, true);
     }
 
@@ -125,6 +168,8 @@ public:
         std::ostringstream oss;
         oss << "DELETE FROM " << db_table << " WHERE id = " << id ;
 
+        zbs_cache.clear();
+
         return db->exec_wr(oss);
     }
 
@@ -139,31 +184,43 @@ public:
      */
     int get(unsigned int hint, unsigned int& bit) const
     {
-        if ( hint != 0 )
+        if ( bs.empty() )
+        {
+            return -1;
+        }
+
+        if ( hint != 0 && hint < N )
         {
-            if ( !bs->test(hint) && !reserved_bit.test(hint) )
+            if ( !test(bs, hint) && !test(reserved_bit, hint) )
             {
-                bs->set(hint);
+                set_bit(hint);
 
                 bit = hint;
                 return 0;
             }
         }
 
-        for (bit = start_bit; ; ++bit)
+        for (unsigned int s = 0; s < SUMMARY; ++s)
         {
-            try
+            uint64_t avail = ~summary[s];
+
+            if ( s == SUMMARY - 1 && WORDS % 64 != 0 )
             {
-                if ( !bs->test(bit) && !reserved_bit.test(bit) )
-                {
-                    bs->set(bit);
-                    return 0;
-                }
+                avail &= (uint64_t(1) << (WORDS % 64)) - 1;
             }
-            catch (const std::out_of_range& oor)
+
+            if ( avail == 0 )
             {
-                return -1;
+                continue;
             }
+
+            unsigned int w = s * 64 + __builtin_ctzll(avail);
+
+            bit = w * 64 + __builtin_ctzll(~(bs[w] | blocked[w]));
+
+            set_bit(bit);
+
+            return 0;
         }
 
         return -1;
@@ -175,11 +232,24 @@ public:
      */
     void reset(int bit)
     {
-        try
+        if ( bit < 0 || static_cast<unsigned int>(bit) >= N || bs.empty() )
         {
-            bs->reset(bit);
+            return;
+        }
+
+        if ( test(bs, bit) )
+        {
+            unsigned int w = bit / 64;
+
+            bs[w] &= ~mask(bit);
+
+            if ( (bs[w] | blocked[w]) != ~uint64_t(0) )
+            {
+                summary[w / 64] &= ~mask(w);
+            }
+
+            dirty = true;
         }
-        catch(const std::out_of_range& oor) {};
     }
 
     /**
@@ -189,20 +259,19 @@ public:
      */
     int set(int bit)
     {
-        int rc = -1;
-
-        try
+        if ( bit < 0 || static_cast<unsigned int>(bit) >= N || bs.empty() )
         {
-            if (bs->test(bit) == false)
-            {
-                bs->set(bit);
+            return -1;
+        }
 
-                rc = 0;
-            }
+        if ( test(bs, bit) )
+        {
+            return -1;
         }
-        catch(const std::out_of_range& oor) {};
 
-        return rc;
+        set_bit(bit);
+
+        return 0;
     }
 
     /**
@@ -214,6 +283,12 @@ public:
     }
 
 private:
+    /**
+     *  Number of 64-bit words of the map and of the summary level
+     */
+    static constexpr unsigned int WORDS   = (N + 63) / 64;
+    static constexpr unsigned int SUMMARY = (WORDS + 63) / 64;
+
     /* ---------------------------------------------------------------------- */
     /* Bitmap configuration attributes                                        */
     /* ---------------------------------------------------------------------- */
@@ -221,9 +296,152 @@ private:
 
     unsigned int start_bit;
 
-    std::bitset<N> reserved_bit;
+    std::vector<uint64_t> reserved_bit;
+
+    /**
+     *  Bits not available to get(): reserved, lower than start_bit or
+     *  greater than N
+     */
+    std::vector<uint64_t> blocked;
+
+    /**
+     *  Bitmap words, and summary with a bit set for each full word
+     */
+    mutable std::vector<uint64_t> bs;
+
+    mutable std::vector<uint64_t> summary;
+
+    /**
+     *  The map has been modified since it was loaded or written
+     */
+    mutable bool dirty = false;
+
+    /**
+     *  Compressed map as last read from or written to the DB
+     */
+    std::string zbs_cache;
+
+    static uint64_t mask(unsigned int bit)
+    {
+        return uint64_t(1) << (bit % 64);
+    }
+
+    static bool test(const std::vector<uint64_t>& words, unsigned int bit)
+    {
+        return (words[bit / 64] & mask(bit)) != 0;
+    }
+
+    void set_bit(unsigned int bit) const
+    {
+        unsigned int w = bit / 64;
+
+        bs[w] |= mask(bit);
+
+        if ( (bs[w] | blocked[w]) == ~uint64_t(0) )
+        {
+            summary[w / 64] |= mask(w);
+        }
+
+        dirty = true;
+    }
+
+    void init_blocked()
+    {
+        blocked = reserved_bit;
+
+        for (unsigned int bit = 0; bit < start_bit && bit < N; ++bit)
+        {
+            blocked[bit / 64] |= mask(bit);
+        }
+
+        for (unsigned int bit = N; bit < WORDS * 64; ++bit)
+        {
+            blocked[bit / 64] |= mask(bit);
+        }
+    }
+
+    void init_summary()
+    {
+        summary.assign(SUMMARY, 0);
+
+        for (unsigned int w = 0; w < WORDS; ++w)
+        {
+            if ( (bs[w] | blocked[w]) == ~uint64_t(0) )
+            {
+                summary[w / 64] |= mask(w);
+            }
+        }
+    }
+
+    /**
+     *  Loads the map from its '0'/'1' representation, the last character
+     *  is bit 0 (same format as std::bitset)
+     *    @return 0 on success
+     */
+    int from_string(const std::string& str)
+    {
+        std::vector<uint64_t> words(WORDS, 0);
+
+        size_t len = str.size() < N ? str.size() : N;
+
+        for (size_t i = 0; i < len; ++i)
+        {
+            unsigned int bit = len - 1 - i;
+
+            switch (str[i])
+            {
+                case '0':
+                    break;
+
+                case '1':
+                    words[bit / 64] |= mask(bit);
+                    break;
+
+                default:
+                    return -1;
+            }
+        }
 
-    std::bitset<N> * bs;
+        bs.swap(words);
+
+        init_summary();
+
+        return 0;
+    }
+
+    /**
+     *  Prints the map without leading zeros ("0" for an empty map)
+     */
+    std::string to_string() const
+    {
+        int top = WORDS - 1;
+
+        while ( top >= 0 && bs[top] == 0 )
+        {
+            --top;
+        }
+
+        if ( top < 0 )
+        {
+            return "0";
+        }
+
+        unsigned int high = top * 64 + 63 - __builtin_clzll(bs[top]);
+
+        std::string str(high + 1, '0');
+
+        for (unsigned int w = 0; w <= static_cast<unsigned int>(top); ++w)
+        {
+            for (uint64_t word = bs[w]; word != 0; word &= word - 1)
+            {
+                unsigned int bit = w * 64 + __builtin_ctzll(word);
+
+                str[high - bit] = '1';
+            }
+        }
+
+        return str;
+    }
 
     /* ---------------------------------------------------------------------- */
     /* Database implementation                                                */
@@ -247,18 +465,15 @@ private:
 
     /**
      *  Loads a the contents of a bitmap from DB
-     *    @param **uzbs, pointer to a string pointer to store the bitmap, must
-     *    be freed by caller.
+     *    @param zbs to store the compressed bitmap
      *    @return 0 on success
      */
-    int select(SqlDB * db, std::string &uzbs)
+    int select(SqlDB * db, std::string &zbs)
     {
         int rc;
 
         std::ostringstream oss;
 
-        std::string zbs;
-
         set_callback(static_cast<Callbackable::Callback>(&BitMap::select_cb),
                      static_cast<void *>(&zbs));
 
@@ -277,7 +492,7 @@ private:
             return -1;
         }
 
-        return ssl_util::zlib_decompress64(zbs, uzbs);
+        return 0;
     }
 
     /**
@@ -291,19 +506,8 @@ private:
         std::ostringstream oss;
 
         std::string zipped;
-        std::string s;
 
-        if (bs->none())
-        {
-            s = "0";
-        }
-        else
-        {
-            s = bs->to_string();
-            s.erase(0, s.find_first_not_of('0'));
-        }
-
-        if (ssl_util::zlib_compress64(s, zipped) != 0)
+        if (ssl_util::zlib_compress64(to_string(), zipped) != 0)
         {
             return -1;
         }
@@ -326,6 +530,16 @@ private:
 
         db->free_str(ezipped64);
 
+        if ( rc == 0 )
+        {
+            zbs_cache = std::move(zipped);
+            dirty     = false;
+        }
+        else
+        {
+            zbs_cache.clear();
+        }
+
         return rc;
     }
 
@@ -382,7 +596,7 @@ private:
 
             for (bit = bit_start; bit <= bit_end && bit < N; bit++)
             {
-                reserved_bit.set(bit);
+                reserved_bit[bit / 64] |= mask(bit);
             }
         }
 
@@ -35,6 +35,7 @@ public:
         : cb(nullptr)
         , arg(nullptr)
         , affected_rows(0)
+        , stream_rows(false)
     {
     }
 
@@ -88,9 +89,31 @@ public:
         cb  = nullptr;
         arg = nullptr;
 
+        stream_rows = false;
+
         _mutex.unlock();
     }
 
+    /**
+     *  Request the DB backend to stream the rows of the next SQL command to
+     *  the callback as they are received, instead of buffering the full
+     *  result set first. The setting is reset by unset_callback. The callback
+     *  function MUST NOT issue new DB queries while rows are being streamed.
+     *    @param stream true to stream the result rows
+     */
+    void set_stream(bool stream)
+    {
+        stream_rows = stream;
+    }
+
+    /**
+     *  @return true if the result rows should be streamed to the callback
+     */
+    bool is_streamed() const
+    {
+        return stream_rows;
+    }
+
     /**
     *  set affected rows variable
     */
@@ -124,6 +147,11 @@ private:
      */
     int affected_rows;
 
+    /**
+     *  Stream result rows to the callback (bounded memory for large reads)
+     */
+    bool stream_rows;
+
     /**
      *  Mutex for locking the callback function.
      */
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 #include <cstdint>
 
 class ClientXRPC;
@@ -107,6 +108,16 @@ public:
                              uint64_t& last,
                              std::string& error_msg);
 
+    // Returns -2 if the endpoint does not implement the batch method
+    static int fed_replicate_batch(const std::string& endpoint,
+                                   uint64_t prev_index,
+                                   const std::vector<uint64_t>& indexes,
+                                   const std::vector<std::string>& sqls,
+                                   time_t timeout_ms,
+                                   bool& success,
+                                   uint64_t& last,
+                                   std::string& error_msg);
+
     static int replicate(const std::string& endpoint,
                          const replicate_params& params,
                          const std::string& sql,
@@ -22,6 +22,9 @@
 #include <grpcpp/grpcpp.h>
 #include <google/protobuf/message.h>
 
+#include <map>
+#include <mutex>
+
 /**
  * This class handles gRPC calls.
  */
@@ -68,6 +71,16 @@ public:
                              uint64_t& last,
                              std::string& error_msg);
 
+    static int fed_replicate_batch(const std::string& endpoint,
+                                   const std::string& secret,
+                                   uint64_t prev_index,
+                                   const std::vector<uint64_t>& indexes,
+                                   const std::vector<std::string>& sqls,
+                                   time_t timeout_ms,
+                                   bool& success,
+                                   uint64_t& last,
+                                   std::string& error_msg);
+
     static int replicate(const std::string& endpoint,
                          const std::string& secret,
                          const replicate_params& params,
@@ -90,6 +103,29 @@ public:
 
 private:
     std::shared_ptr<grpc::Channel> channel;
+
+    /**
+     *  Channels to the peers (Raft servers and federation zones), created on
+     *  first use and shared by all the replication calls to the endpoint. The
+     *  channel keeps the HTTP/2 connection open and reconnects with backoff.
+     */
+    static std::map<std::string, std::shared_ptr<grpc::Channel>> peer_channels;
+
+    static std::mutex peer_mutex;
+
+    static std::shared_ptr<grpc::Channel> peer_channel(const std::string& endpoint);
+
+    /**
+     *  Sets the deadline of a peer call, timeout_ms = 0 means no deadline
+     */
+    static void set_deadline(grpc::ClientContext& context, time_t timeout_ms)
+    {
+        if ( timeout_ms > 0 )
+        {
+            context.set_deadline(std::chrono::system_clock::now() +
+                                 std::chrono::milliseconds(timeout_ms));
+        }
+    }
 };
 
 #endif
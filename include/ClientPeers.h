@@ -0,0 +1,111 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+#ifndef CLIENT_PEERS_H_
+#define CLIENT_PEERS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ *  State of the peers (Raft servers and federation zones) called by the
+ *  replication RPCs. It keeps per endpoint call statistics and implements an
+ *  exponential backoff: after a failed call the peer is not called again until
+ *  the backoff time expires, so unreachable peers do not hold the replication
+ *  threads for a full RPC timeout on every try.
+ */
+class ClientPeers
+{
+public:
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    /**
+     *  Singleton accessor
+     */
+    static ClientPeers& instance()
+    {
+        static ClientPeers peers;
+
+        return peers;
+    }
+
+    /**
+     *  Starts a call to a peer
+     *    @param endpoint of the peer
+     *    @param start time of the call
+     *    @param error message if the peer is in backoff
+     *    @return true if the call can be made
+     */
+    bool start_call(const std::string& endpoint, time_point& start,
+                    std::string& error);
+
+    /**
+     *  Records the result of a call, and updates the backoff of the peer
+     *    @param endpoint of the peer
+     *    @param start time of the call, as returned by start_call
+     *    @param ok true if the RPC reached the peer
+     */
+    void end_call(const std::string& endpoint, const time_point& start, bool ok);
+
+    /**
+     *  Removes the peer state, the next call is made without backoff
+     */
+    void reset(const std::string& endpoint);
+
+    /**
+     *  Peer statistics in XML format:
+     *  <PEERS><PEER><ENDPOINT/><CALLS/><ERRORS/><FAILURES/><RTT/><LAST_RTT/>
+     *  </PEER></PEERS>. RTT (EWMA) and LAST_RTT are in milliseconds.
+     */
+    std::string& to_xml(std::string& xml);
+
+private:
+    ClientPeers() = default;
+
+    struct Peer
+    {
+        uint64_t calls  = 0;
+        uint64_t errors = 0;
+
+        // Consecutive failed calls
+        unsigned int failures = 0;
+
+        double rtt      = 0;
+        double last_rtt = 0;
+
+        time_point retry;
+    };
+
+    /**
+     *  Backoff limits in milliseconds, doubled on each consecutive failure
+     */
+    static constexpr unsigned int MIN_BACKOFF = 100;
+    static constexpr unsigned int MAX_BACKOFF = 2000;
+
+    /**
+     *  Weight of the last call in the RTT moving average
+     */
+    static constexpr double RTT_ALPHA = 0.2;
+
+    std::mutex peers_mutex;
+
+    std::map<std::string, Peer> peers;
+};
+
+#endif /*CLIENT_PEERS_H_*/
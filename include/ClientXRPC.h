@@ -23,6 +23,9 @@
 #include <xmlrpc-c/client_simple.hpp>
 #include <xmlrpc-c/girerr.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 // =============================================================================
@@ -79,6 +82,16 @@ public:
                              uint64_t& last,
                              std::string& error_msg);
 
+    static int fed_replicate_batch(const std::string& endpoint,
+                                   const std::string& secret,
+                                   uint64_t prev_index,
+                                   const std::vector<uint64_t>& indexes,
+                                   const std::vector<std::string>& sqls,
+                                   time_t timeout_ms,
+                                   bool& success,
+                                   uint64_t& last,
+                                   std::string& error_msg);
+
     static int replicate(const std::string& endpoint,
                          const std::string& secret,
                          const replicate_params& params,
@@ -117,7 +130,8 @@ public:
      *    @param timeout (ms) for the request, set 0 for global xml_rpc timeout
      *    @param result of the xmlrpc call
      *    @param error string if any
-     *    @return 0
+     *    @return 0 on success, -2 if the server does not implement the method
+     *    and -1 for other errors
      */
     static int call(const std::string& endpoint,
                     const std::string& method,
@@ -141,6 +155,24 @@ public:
               ...);
 
 private:
+    /**
+     *  Transport to a peer endpoint. It is reused by the calls to the
+     *  endpoint, so the HTTP connection is kept alive in the curl connection
+     *  cache. Only one call can use the transport at a time; concurrent calls
+     *  use a new transport.
+     */
+    struct PeerTransport
+    {
+        std::mutex mtx;
+
+        std::unique_ptr<xmlrpc_c::clientXmlTransport_curl> transport;
+    };
+
+    static std::map<std::string, std::unique_ptr<PeerTransport>> peer_transports;
+
+    static std::mutex peer_mutex;
+
+    static PeerTransport * peer_transport(const std::string& endpoint);
 };
 
 #endif
@@ -58,11 +58,27 @@ public:
     uint64_t apply_log_record(uint64_t index, uint64_t prev, const std::string& sql);
 
     /**
-     *  Record was successfully replicated on zone, increase next index and
+     *  Applies a batch of consecutive federated records [SLAVE]. Records are
+     *  applied in order and processing stops at the first failure.
+     *    @param prev index preceding the first record of the batch
+     *    @param indexes of the records
+     *    @param sqls commands to apply to DB, one for each index
+     *    @param applied number of records applied
+     *    @return 0 on success, last_index if missing records, UINT64_MAX on
+     *    DB error (the failed record is indexes[applied])
+     */
+    uint64_t apply_log_records(uint64_t prev,
+                               const std::vector<uint64_t>& indexes,
+                               const std::vector<std::string>& sqls,
+                               size_t& applied);
+
+    /**
+     *  Records were successfully replicated on zone, increase next index and
      *  send any pending records.
      *    @param zone_id
+     *    @param last index replicated in the zone
      */
-    void replicate_success(int zone_id);
+    void replicate_success(int zone_id, uint64_t last);
 
     /**
      *  Record could not be replicated on zone, decrease next index and
@@ -72,7 +88,9 @@ public:
     void replicate_failure(int zone_id, uint64_t zone_last);
 
     /**
-     *  RPC API call to replicate a log entry on slaves
+     *  RPC API call to replicate the next log entries on slaves. Records are
+     *  sent in batches, falling back to single record calls for slaves that
+     *  do not support one.zone.fedreplicatebatch
      *     @param zone_id
      *     @param success status of API call
      *     @param last index replicate in zone slave
@@ -129,16 +147,27 @@ private:
     // -------------------------------------------------------------------------
     // Synchronization variables
     //   - rpc_timeout_ms. To timeout api calls to replicate log
+    //   - batch_max_records, batch_max_bytes. Limits for a replication batch
+    //   - batch_retry. Seconds before batching is tried again on a zone
     //   - zones list of zones in the federation with:
     //     - list of servers <id, rpc endpoint>
     //     - next index to send to this zone
+    //     - batch mode and catch-up statistics
     // -------------------------------------------------------------------------
     static const time_t rpc_timeout_ms;
 
+    static const size_t batch_max_records;
+
+    static const size_t batch_max_bytes;
+
+    static const time_t batch_retry;
+
     struct ZoneServers
     {
         ZoneServers(int z, uint64_t l, const std::string& s):
-            zone_id(z), endpoint(s), next(l), last(UINT64_MAX) {};
+            zone_id(z), endpoint(s), next(l), last(UINT64_MAX), batch(true),
+            batch_time(0), sync_start(0), sync_records(0), sync_bytes(0),
+            sync_rpcs(0) {};
 
         ~ZoneServers() {};
 
@@ -149,6 +178,14 @@ private:
         uint64_t next;
 
         uint64_t last;
+
+        bool   batch;
+        time_t batch_time;
+
+        time_t   sync_start;
+        uint64_t sync_records;
+        uint64_t sync_bytes;
+        uint64_t sync_rpcs;
     };
 
     std::map<int, ZoneServers *> zones;
@@ -156,16 +193,30 @@ private:
     LogDB * logdb;
 
     /**
-     *  Get the nerxt record to replicate in a zone
+     *  Get the indexes of the next records to replicate in a zone
      *    @param zone_id of the zone
      *    @param zedp zone endpoint
-     *    @param lr log record
+     *    @param prev index preceding the first record
+     *    @param indexes of the records to send, consecutive in the fed log
+     *    @param batch true if the zone accepts batches
      *    @param error description if any
      *
-     *    @return 0 on success, -1 otherwise
+     *    @return 0 on success, -2 no new records, -1 otherwise
+     */
+    int get_next_records(int zone_id, std::string& zedp, uint64_t& prev,
+                         std::vector<uint64_t>& indexes, bool& batch,
+                         std::string& error);
+
+    /**
+     *  Updates the replication statistics of a zone after a RPC call
+     *    @param zone_id of the zone
+     *    @param rc of the RPC call
+     *    @param batch true if the call used the batch method
+     *    @param records number of records sent
+     *    @param bytes size of the records sent
      */
-    int get_next_record(int zone_id, std::string& zedp, LogDBRecord& lr,
-                        std::string& error);
+    void rpc_stats(int zone_id, int rc, bool batch, size_t records,
+                   size_t bytes);
 
 };
 
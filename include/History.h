@@ -111,6 +111,16 @@ private:
 
     std::string  vm_info;
 
+    // -------------------------------------------------------------------------
+    // Accounting data, derived from the VM info (history_acct table)
+    // -------------------------------------------------------------------------
+    int          vm_uid = -1;
+    int          vm_gid = -1;
+
+    float        cpu    = 0;
+    long long    memory = 0;
+    long long    disk   = 0;
+
     // -------------------------------------------------------------------------
     // Non-persistent history fields
     // -------------------------------------------------------------------------
@@ -169,6 +179,14 @@ private:
      */
     int insert_replace(SqlDB *db, bool replace);
 
+    /**
+     *  Writes the numeric accounting data of the record in the history_acct
+     *  table, used to aggregate accounting without parsing the record body
+     *    @param db The SQL DB
+     *    @return 0 on success
+     */
+    int insert_replace_acct(SqlDB *db);
+
     /**
      *  Callback function to unmarshall a history object (History::select)
      *    @param num the number of columns read from the DB
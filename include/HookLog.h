@@ -17,15 +17,22 @@
 #ifndef HOOKLOG_H_
 #define HOOKLOG_H_
 
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "Attribute.h"
+#include "Listener.h"
 
 class SqlDB;
 
 /**
  *  This class represents the execution log of Hooks. It writes/reads execution
- *  records in the DB.
+ *  records in the DB. New records are buffered and written in batches, the
+ *  last execution id of each hook is cached and old records are trimmed
+ *  periodically. Any read of the log flushes the buffer first.
  */
 class HookLog
 {
@@ -33,7 +40,24 @@ public:
 
     HookLog(SqlDB *db, const VectorAttribute * hl_conf);
 
-    virtual ~HookLog() = default;
+    virtual ~HookLog();
+
+    /**
+     *  Stops the flush timer and writes any pending record to the DB
+     */
+    void finalize();
+
+    /**
+     *  Writes the buffered execution records to the DB, only on the leader
+     *    @return 0 on success
+     */
+    int flush();
+
+    /**
+     *  Drops the buffered records and cached execution ids, when the server
+     *  is no longer the leader
+     */
+    void reset();
 
     /**
      *  Get the execution log for a given hook
@@ -111,6 +135,60 @@ private:
      */
     int log_retention;
 
+    // ----------------------------------------
+    // Buffered writer
+    // ----------------------------------------
+
+    Timer timer_thread;
+
+    /**
+     *  Protects the caches and the record buffer
+     */
+    std::mutex hl_mutex;
+
+    /**
+     *  Serializes flush and trim operations
+     */
+    std::mutex flush_mutex;
+
+    /**
+     *  Last execution id of each hook <hkid, exeid>
+     */
+    std::map<int, int> last_exeid;
+
+    /**
+     *  Hooks with new records since the last retention trim
+     */
+    std::set<int> trim_hooks;
+
+    /**
+     *  Buffered execution record, failed writes are retried on next flush
+     */
+    struct Record
+    {
+        int         hkid;
+        std::string values; // SQL values tuple
+        int         retries;
+    };
+
+    /**
+     *  Pending records
+     */
+    std::vector<Record> pending;
+
+    time_t last_trim;
+
+    /**
+     *  Flushes the buffer and trims the log of active hooks periodically
+     */
+    void timer_action();
+
+    /**
+     *  Deletes the records beyond log_retention for the hooks with new
+     *  records. flush_mutex MUST be locked
+     */
+    void trim();
+
     /**
      *  Dumps hook log records
      *    @param hkid -1 to dump all records
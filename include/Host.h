@@ -190,6 +190,14 @@ public:
      **/
     int update_info(Template &tmpl);
 
+    /**
+     * Prints the host attributes set by update_info: state, capacity (share,
+     * PCI and NUMA) and template (wilds, error). Used to detect changes
+     *    @param xml the resulting XML string
+     *    @return a reference to the generated string
+     **/
+    std::string& system_to_xml(std::string& xml) const;
+
     /**
      * Retrieves host state
      *    @return HostState code number
@@ -235,6 +243,11 @@ public:
         return host_share.get_running_vms();
     }
 
+    const HostShare& get_host_share() const
+    {
+        return host_share;
+    }
+
     /**
      *  Adds a new VM to the host share by incrementing usage counters
      *    @param sr the capacity request of the VM
@@ -365,6 +378,11 @@ public:
         cluster_template_xml = e;
     }
 
+    const std::string& cluster_template() const
+    {
+        return cluster_template_xml;
+    }
+
     bool is_pinned() const;
 private:
     friend class HostPool;
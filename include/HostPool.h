@@ -25,6 +25,8 @@
 #include <sstream>
 
 #include <vector>
+#include <map>
+#include <mutex>
 
 /**
  *  The Host Pool class.
@@ -195,7 +197,14 @@ public:
             return -1;
         }
 
-        return PoolSQL::drop(objsql, error_msg);
+        int rc = PoolSQL::drop(objsql, error_msg);
+
+        if ( rc == 0 )
+        {
+            drop_capacity(host->get_oid());
+        }
+
+        return rc;
     };
 
     /**
@@ -264,7 +273,124 @@ public:
      */
     HostMonitoringTemplate get_monitoring(int hid);
 
+    // -------------------------------------------------------------------------
+    // Host capacity snapshot
+    // -------------------------------------------------------------------------
+    /**
+     *  Numeric capacity record of a Host. The snapshot version is increased
+     *  every time a record changes, each record stores the version of its
+     *  last change. Deleted hosts are kept with state -1.
+     */
+    struct Capacity
+    {
+        int oid;
+        int cluster_id;
+        int state;
+
+        long long cpu_usage;
+        long long max_cpu;
+        long long total_cpu;
+
+        long long mem_usage;
+        long long max_mem;
+        long long total_mem;
+
+        long long running_vms;
+
+        int pci_total;
+        int pci_free;
+
+        int numa_nodes;
+
+        uint64_t version;
+    };
+
+    /**
+     *  Gets the capacity records changed after a given version. The snapshot
+     *  is updated on every host write. Followers do not write hosts, they
+     *  return no records, version 0 and epoch 0.
+     *    @param epoch of the snapshot of the last call. All the records are
+     *    returned if it is not the current one. It is set to the current
+     *    epoch.
+     *    @param since version of the last call, 0 to get all the hosts
+     *    @param records changed after since
+     *    @return the current version of the snapshot
+     */
+    uint64_t get_capacity(uint64_t& epoch, uint64_t since,
+                          std::vector<Capacity>& records);
+
+    /**
+     *  Drops the capacity snapshot and starts a new epoch. It is called on
+     *  Raft leader changes, as other servers may have updated the hosts. The
+     *  snapshot is loaded again from the DB on next use.
+     */
+    void reset_capacity();
+
+    /**
+     *  Prints capacity records in XML format
+     *    @param epoch of the snapshot
+     *    @param version of the snapshot
+     *    @param records to print
+     *    @param xml the resulting XML string
+     *    @return a reference to the generated string
+     */
+    static std::string& capacity_to_xml(uint64_t epoch,
+                                        uint64_t version,
+                                        const std::vector<Capacity>& records,
+                                        std::string& xml);
+
+    /**
+     *  Returns the write version of a host. It is increased every time the
+     *  host is updated, 0 if the host has not been updated since start.
+     *    @param oid of the host
+     */
+    uint64_t get_write_version(int oid);
+
 private:
+    /**
+     *  Capacity records of the hosts, by host id
+     */
+    std::map<int, Capacity> capacity;
+
+    uint64_t capacity_version = 0;
+
+    /**
+     *  Epoch of the snapshot, versions are only comparable within an epoch
+     */
+    uint64_t capacity_epoch;
+
+    /**
+     *  Write versions of the hosts, by host id
+     */
+    std::map<int, uint64_t> write_versions;
+
+    uint64_t write_version = 0;
+
+    bool capacity_loaded = false;
+
+    std::mutex capacity_mutex;
+
+    /**
+     *  Gets the capacity record of a host
+     */
+    static void host_capacity(const Host * host, Capacity& record);
+
+    /**
+     *  Updates the capacity record of a host, the version is only increased
+     *  if the capacity has changed
+     */
+    void set_capacity(const Host * host);
+
+    /**
+     *  Marks the capacity record of a host as deleted
+     */
+    void drop_capacity(int oid);
+
+    /**
+     *  Reads the capacity records of all the hosts from the DB
+     */
+    void load_capacity(std::vector<Capacity>& records);
+
     /**
      *  Factory method to produce Host objects
      *    @return a pointer to the new Host
@@ -186,6 +186,27 @@ public:
     long long get_max_mem() const { return max_mem; }
     long long get_max_cpu() const { return max_cpu; }
 
+    long long get_mem_usage() const { return mem_usage; }
+    long long get_cpu_usage() const { return cpu_usage; }
+
+    /**
+     *  Counts the PCI devices of the host
+     *    @param total number of devices
+     *    @param free number of devices not assigned to a VM
+     */
+    void pci_count(int& total, int& free) const
+    {
+        pci.count(total, free);
+    }
+
+    /**
+     *  Return the number of NUMA nodes of the host
+     */
+    int numa_nodes() const
+    {
+        return numa.size();
+    }
+
 private:
 
     long long mem_usage;  /**< Memory allocated to VMs (in KB)       */
@@ -361,6 +361,14 @@ public:
      */
     HostShareNode& get_node(int idx);
 
+    /**
+     *  @return the number of NUMA nodes
+     */
+    int size() const
+    {
+        return nodes.size();
+    }
+
     /**
      * Function to print the HostShare object into a string in
      * XML format
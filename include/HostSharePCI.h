@@ -75,6 +75,25 @@ public:
      */
     bool test(const std::vector<VectorAttribute *> &devs) const;
 
+    /**
+     *  Counts the PCI devices
+     *    @param total number of devices
+     *    @param free number of devices not assigned to a VM
+     */
+    void count(int& total, int& free) const
+    {
+        total = pci_devices.size();
+        free  = 0;
+
+        for (const auto& dev : pci_devices)
+        {
+            if ( dev.second->vmid == -1 )
+            {
+                free++;
+            }
+        }
+    }
+
     /**
      *  Assign the requested devices to the given VM. The assigned devices will
      *  be labeled with the VM and the PCI attribute of the VM extended with
@@ -19,9 +19,12 @@
 
 #include "DriverManager.h"
 #include "Listener.h"
+#include "Metrics.h"
 #include "ProtocolMessages.h"
 #include "RaftManager.h"
 
+#include <atomic>
+
 class HostPool;
 class Host;
 class VirtualMachinePool;
@@ -37,9 +40,26 @@ public:
         , hpool(_hpool)
         , vmpool(_vmpool)
     {
+        // HOST_SYSTEM messages written to the DB or skipped because they did
+        // not change the host, exported through one.system.metrics
+        Metrics::instance().add_gauge("one_host_system_updates",
+                                      "result=\"written\"",
+                                      [this] { return host_updates.load() -
+                                               host_updates_skipped.load(); });
+
+        Metrics::instance().add_gauge("one_host_system_updates",
+                                      "result=\"skipped\"",
+                                      [this] { return host_updates_skipped.load(); });
     }
 
-    ~InformationManager() = default;
+    ~InformationManager()
+    {
+        Metrics::instance().del_gauge("one_host_system_updates",
+                                      "result=\"written\"");
+
+        Metrics::instance().del_gauge("one_host_system_updates",
+                                      "result=\"skipped\"");
+    }
 
     /**
      *  This functions starts the associated listener thread, and creates a
@@ -129,6 +149,13 @@ private:
      */
     VirtualMachinePool * vmpool;
 
+    /**
+     *  HOST_SYSTEM update counters
+     */
+    std::atomic<uint64_t> host_updates{0};
+
+    std::atomic<uint64_t> host_updates_skipped{0};
+
     /**
      *  Default timeout to wait for Information Driver (monitord)
      */
@@ -203,6 +203,11 @@ public:
     void trigger_updatevnet(int vnid);
 
 private:
+    /**
+     *  Maximum number of VMs updated in each security group batch
+     */
+    static constexpr size_t SG_BATCH_SIZE = 500;
+
     /**
      *  Pointer to the Virtual Machine Pool, to access VMs
      */
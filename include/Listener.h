@@ -26,6 +26,7 @@
 #include <thread>
 
 #include "NebulaLog.h"
+#include "Metrics.h"
 
 /**
  *  The Timer class executes a given action periodically in a separate thread.
@@ -132,11 +133,23 @@ public:
     Listener(const std::string& _name)
         : name(_name)
     {
+        if (!name.empty())
+        {
+            Metrics::instance().add_gauge("one_listener_queue_depth",
+                                          "listener=\"" + name + "\"",
+                                          [this] { return depth.load(); });
+        }
     }
 
     virtual ~Listener()
     {
         join_thread();
+
+        if (!name.empty())
+        {
+            Metrics::instance().del_gauge("one_listener_queue_depth",
+                                          "listener=\"" + name + "\"");
+        }
     }
 
     /**
@@ -151,6 +164,8 @@ public:
 
         pending.push(f);
 
+        depth = pending.size();
+
         ul.unlock();
 
         cond.notify_one();
@@ -220,6 +235,8 @@ protected:
 
                 fn = pending.front();
                 pending.pop();
+
+                depth = pending.size();
             }
 
             fn();
@@ -242,6 +259,9 @@ private:
     std::condition_variable cond;
 
     std::queue<std::function<void()>> pending;
+
+    // Number of pending events, exported as a metric
+    std::atomic<uint64_t> depth{0};
 };
 
 #endif /*LISTENER_H_*/
@@ -18,7 +18,10 @@
 #define _LOG_H_
 
 #include <string>
+#include <atomic>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <syslog.h>
 
@@ -57,6 +60,16 @@ public:
         zone_id = zid;
     }
 
+    /**
+     *  Formats a log line: "<date> [Z<zone>][<module>][<type>]: <message>\n"
+     *    @param line the formatted line
+     */
+    static void format_line(
+            std::string&            line,
+            const char *            module,
+            const MessageType       type,
+            const char *            message);
+
     // -------------------------------------------------------------------------
     // Profiler Interface
     // -------------------------------------------------------------------------
@@ -104,6 +117,8 @@ protected:
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+class LogWriter;
+
 /**
  *  Log messages to a log file
  */
@@ -121,8 +136,27 @@ public:
             const MessageType       type,
             const char *            message) override;
 
+    /**
+     *  Sets the writer for all FileLog instances. If set, lines are queued to
+     *  the writer thread instead of written by the caller. It returns when no
+     *  thread is using the previous writer, so it can be finalized.
+     */
+    static void set_writer(LogWriter * _writer);
+
+    static LogWriter * get_writer()
+    {
+        return writer.load();
+    }
+
 private:
-    std::string log_file_name;
+    std::shared_ptr<const std::string> log_file_name;
+
+    static std::atomic<LogWriter *> writer;
+
+    /**
+     *  Number of threads queuing a line in the writer
+     */
+    static std::atomic<int> producers;
 };
 
 /**
@@ -145,6 +179,12 @@ public:
             const MessageType       type,
             const char *            message) override
     {
+        if ( get_writer() != nullptr )
+        {
+            FileLog::log(module, type, message);
+            return;
+        }
+
         std::lock_guard <std::mutex> lock(log_mutex);
         FileLog::log(module, type, message);
     }
@@ -82,8 +82,12 @@ private:
 class LogDB : public SqlDB
 {
 public:
+    /**
+     *  @param snapshot path of the federated index snapshot, empty to always
+     *  build the index from the DB
+     */
     LogDB(SqlDB * _db, bool solo, bool cache, uint64_t log_retention,
-          uint64_t limit_purge);
+          uint64_t limit_purge, const std::string& snapshot = "");
 
     virtual ~LogDB();
 
@@ -323,6 +327,11 @@ private:
      */
     uint64_t limit_purge;
 
+    /**
+     *  Path of the federated index snapshot
+     */
+    std::string snapshot_file;
+
     // -------------------------------------------------------------------------
     // Federated Log
     // -------------------------------------------------------------------------
@@ -335,8 +344,31 @@ private:
     /**
      *  Generates the federated index, it should be called whenever a server
      *  takes leadership.
+     *    @param full read the index from the DB. Otherwise the index is loaded
+     *    from the snapshot and only the newer records are read from the DB
      */
-    void build_federated_index();
+    void build_federated_index(bool full);
+
+    /**
+     *  Loads the federated index from the snapshot file. The snapshot is
+     *  tagged with the index and term of the last log record, it is only
+     *  valid if the log still has a record with that index and term.
+     *    @param index of the last record included in the snapshot
+     *
+     *    @return 0 on success
+     */
+    int load_fed_snapshot(uint64_t& index);
+
+    /**
+     *  Writes the federated index and the last log record in the snapshot
+     *  file. The file has a binary format (host byte order):
+     *    "ONELOGDB" | version | index | term | size | fed_index ... | crc32
+     */
+    void save_fed_snapshot();
+
+    static const char SNAPSHOT_MAGIC[8];
+
+    static const uint32_t SNAPSHOT_VERSION;
 
     // -------------------------------------------------------------------------
     // DataBase implementation
@@ -0,0 +1,150 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+
+#ifndef LOG_WRITER_H_
+#define LOG_WRITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ *  The LogWriter writes log lines to files in a separate thread. Lines are
+ *  queued by the producers in a bounded lock-free ring and the writer thread
+ *  drains the ring in batches, appending the lines of each file (oned.log and
+ *  vm.log's) with a single writev call per batch.
+ *
+ *  When the ring is full the line is either dropped (DROP) or the producer
+ *  waits for the writer to free some space (BLOCK). The number of dropped
+ *  lines is reported in the main log file.
+ */
+class LogWriter
+{
+public:
+    enum Overflow
+    {
+        BLOCK = 0,
+        DROP  = 1
+    };
+
+    /**
+     *  @param main_file path of the daemon log file, used to report dropped
+     *    lines
+     *  @param size of the ring, rounded up to a power of 2
+     *  @param overflow policy when the ring is full
+     */
+    LogWriter(const std::string& main_file, size_t size, Overflow overflow);
+
+    ~LogWriter();
+
+    /**
+     *  Queues a line to be appended to a file
+     *    @param file path of the log file
+     *    @param line formatted line, including the trailing new line
+     *    @param urgent wake up the writer thread to write the line now
+     */
+    void write(const std::shared_ptr<const std::string>& file,
+               std::string&& line,
+               bool urgent);
+
+    /**
+     *  Writes the pending lines and stops the writer thread. The writer must
+     *  be removed from FileLog first (FileLog::set_writer), so no new lines
+     *  are queued while the thread exits. Lines written after finalize are
+     *  appended by the calling thread.
+     */
+    void finalize();
+
+    static Overflow str_to_overflow(const std::string& str);
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const std::string> file;
+
+        std::string line;
+    };
+
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+
+        Entry entry;
+    };
+
+    /**
+     *  Maximum number of lines written in a batch
+     */
+    static constexpr size_t MAX_BATCH = 1024;
+
+    /**
+     *  Maximum time a line stays in the ring
+     */
+    static constexpr std::chrono::milliseconds FLUSH_PERIOD{50};
+
+    std::string main_file;
+
+    Overflow overflow;
+
+    // -------------------------------------------------------------------------
+    // Multiple producer, single consumer ring. Each cell has a sequence number
+    // that tells producers and consumer if it is free or holds an entry.
+    // -------------------------------------------------------------------------
+    std::unique_ptr<Cell[]> ring;
+
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+
+    alignas(64) size_t dequeue_pos = 0;
+
+    alignas(64) std::atomic<uint64_t> dropped{0};
+
+    std::atomic<int> blocked{0};
+
+    std::atomic<bool> end{false};
+
+    std::mutex writer_mutex;
+
+    std::condition_variable cond;
+
+    std::thread writer_thread;
+
+    bool push(Entry& e);
+
+    bool pop(Entry& e);
+
+    /**
+     *  Writer thread loop
+     */
+    void do_write();
+
+    /**
+     *  Appends the lines of the batch, grouped by file. The batch is cleared.
+     */
+    void write_batch(std::vector<Entry>& batch);
+
+    static void write_file(const std::string& file,
+                           const std::vector<const std::string *>& lines);
+};
+
+#endif /*LOG_WRITER_H_*/
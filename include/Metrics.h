@@ -0,0 +1,348 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+/**
+ *  Latency histogram with fixed buckets. Observations only update atomic
+ *  counters so they can be recorded from any thread without locking.
+ */
+class LatencyHistogram
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     *  Upper bound of each bucket in microseconds, the last bucket (+Inf) is
+     *  not included
+     */
+    static constexpr std::array<uint64_t, 16> BOUNDS =
+    {
+        100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000,
+        250000, 500000, 1000000, 2500000, 5000000, 10000000
+    };
+
+    void observe(uint64_t us)
+    {
+        size_t i = 0;
+
+        while ( i < BOUNDS.size() && us > BOUNDS[i] )
+        {
+            ++i;
+        }
+
+        buckets[i].fetch_add(1, std::memory_order_relaxed);
+
+        sum.fetch_add(us, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     *  Records the time elapsed since start
+     */
+    void observe(const clock::time_point& start)
+    {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          clock::now() - start).count();
+
+        observe(us < 0 ? 0 : static_cast<uint64_t>(us));
+    }
+
+    uint64_t get_count() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t get_sum() const
+    {
+        return sum.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  @return number of observations in bucket i, i == BOUNDS.size() is the
+     *  +Inf bucket
+     */
+    uint64_t get_bucket(size_t i) const
+    {
+        return buckets[i].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BOUNDS.size() + 1> buckets{};
+
+    std::atomic<uint64_t> sum{0};
+
+    std::atomic<uint64_t> count{0};
+};
+
+/**
+ *  Registry of the oned internal metrics (latency histograms and gauges). The
+ *  metrics are exported through one.system.metrics as XML or in the
+ *  Prometheus text format.
+ *
+ *  Metrics are identified by a name and a Prometheus label set, e.g.:
+ *    one_rpc_seconds, method="one.vm.info",phase="total"
+ */
+class Metrics
+{
+public:
+    /**
+     *  The registry is never destroyed, so objects destroyed on exit (e.g.
+     *  Listeners) can still remove their gauges.
+     */
+    static Metrics& instance()
+    {
+        static Metrics * metrics = new Metrics();
+
+        return *metrics;
+    }
+
+    /**
+     *  Gets a histogram, it is created the first time it is used and it is
+     *  never removed. Each thread caches the histograms it uses, so the
+     *  registry lock is only taken the first time a thread uses a metric.
+     *    @param name of the metric
+     *    @param labels of the metric, e.g. method="one.vm.info"
+     *    @return reference to the histogram, valid for the process lifetime
+     */
+    LatencyHistogram& histogram(const std::string& name,
+                                const std::string& labels = "")
+    {
+        thread_local std::unordered_map<std::string, LatencyHistogram*> cache;
+
+        std::string key = name + "{" + labels + "}";
+
+        auto it = cache.find(key);
+
+        if ( it != cache.end() )
+        {
+            return *(it->second);
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        auto& hist = histograms[key];
+
+        if ( !hist.histogram )
+        {
+            hist.name   = name;
+            hist.labels = labels;
+
+            hist.histogram = std::make_unique<LatencyHistogram>();
+        }
+
+        cache.emplace(key, hist.histogram.get());
+
+        return *hist.histogram;
+    }
+
+    /**
+     *  Adds a gauge, the value is read with the given function when the
+     *  metrics are exported
+     */
+    void add_gauge(const std::string& name,
+                   const std::string& labels,
+                   std::function<uint64_t()> value)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        auto& gauge = gauges[name + "{" + labels + "}"];
+
+        gauge.name   = name;
+        gauge.labels = labels;
+        gauge.value  = std::move(value);
+    }
+
+    void del_gauge(const std::string& name, const std::string& labels)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        gauges.erase(name + "{" + labels + "}");
+    }
+
+    /**
+     *  <METRICS>
+     *    <HISTOGRAM>
+     *      <NAME/><LABELS/><COUNT/><SUM/> (seconds)
+     *      <BUCKET><LE/><COUNT/></BUCKET> (cumulative, as in Prometheus)
+     *    </HISTOGRAM>
+     *    <GAUGE><NAME/><LABELS/><VALUE/></GAUGE>
+     *  </METRICS>
+     */
+    std::string to_xml() const
+    {
+        std::ostringstream oss;
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        oss << std::fixed << std::setprecision(6) << "<METRICS>";
+
+        for (const auto& [key, hist] : histograms)
+        {
+            const LatencyHistogram& h = *hist.histogram;
+
+            uint64_t cumulative = 0;
+
+            oss << "<HISTOGRAM>"
+                << "<NAME>" << hist.name << "</NAME>"
+                << "<LABELS><![CDATA[" << hist.labels << "]]></LABELS>"
+                << "<COUNT>" << h.get_count() << "</COUNT>"
+                << "<SUM>" << h.get_sum() / 1e6 << "</SUM>";
+
+            for (size_t i = 0; i <= LatencyHistogram::BOUNDS.size(); ++i)
+            {
+                cumulative += h.get_bucket(i);
+
+                oss << "<BUCKET><LE>" << bound(i) << "</LE>"
+                    << "<COUNT>" << cumulative << "</COUNT></BUCKET>";
+            }
+
+            oss << "</HISTOGRAM>";
+        }
+
+        for (const auto& [key, gauge] : gauges)
+        {
+            oss << "<GAUGE>"
+                << "<NAME>" << gauge.name << "</NAME>"
+                << "<LABELS><![CDATA[" << gauge.labels << "]]></LABELS>"
+                << "<VALUE>" << gauge.value() << "</VALUE>"
+                << "</GAUGE>";
+        }
+
+        oss << "</METRICS>";
+
+        return oss.str();
+    }
+
+    /**
+     *  Metrics in the Prometheus text exposition format
+     */
+    std::string to_prometheus() const
+    {
+        std::ostringstream oss;
+        std::string        last;
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        oss << std::fixed << std::setprecision(6);
+
+        for (const auto& [key, hist] : histograms)
+        {
+            const LatencyHistogram& h = *hist.histogram;
+
+            std::string sep = hist.labels.empty() ? "" : ",";
+
+            uint64_t cumulative = 0;
+
+            if ( hist.name != last )
+            {
+                oss << "# TYPE " << hist.name << " histogram\n";
+                last = hist.name;
+            }
+
+            for (size_t i = 0; i <= LatencyHistogram::BOUNDS.size(); ++i)
+            {
+                cumulative += h.get_bucket(i);
+
+                oss << hist.name << "_bucket{" << hist.labels << sep
+                    << "le=\"" << bound(i) << "\"} " << cumulative << "\n";
+            }
+
+            oss << hist.name << "_sum" << label_set(hist.labels) << " "
+                << h.get_sum() / 1e6 << "\n";
+
+            oss << hist.name << "_count" << label_set(hist.labels) << " "
+                << h.get_count() << "\n";
+        }
+
+        for (const auto& [key, gauge] : gauges)
+        {
+            if ( gauge.name != last )
+            {
+                oss << "# TYPE " << gauge.name << " gauge\n";
+                last = gauge.name;
+            }
+
+            oss << gauge.name << label_set(gauge.labels) << " "
+                << gauge.value() << "\n";
+        }
+
+        return oss.str();
+    }
+
+private:
+    Metrics() = default;
+
+    struct Histogram
+    {
+        std::string name;
+        std::string labels;
+
+        std::unique_ptr<LatencyHistogram> histogram;
+    };
+
+    struct Gauge
+    {
+        std::string name;
+        std::string labels;
+
+        std::function<uint64_t()> value;
+    };
+
+    mutable std::mutex mtx;
+
+    std::map<std::string, Histogram> histograms;
+
+    std::map<std::string, Gauge> gauges;
+
+    static std::string label_set(const std::string& labels)
+    {
+        return labels.empty() ? "" : "{" + labels + "}";
+    }
+
+    /**
+     *  @return the upper bound of bucket i in seconds
+     */
+    static std::string bound(size_t i)
+    {
+        if ( i >= LatencyHistogram::BOUNDS.size() )
+        {
+            return "+Inf";
+        }
+
+        std::ostringstream oss;
+
+        oss << LatencyHistogram::BOUNDS[i] / 1e6;
+
+        return oss.str();
+    }
+};
+
+#endif /*METRICS_H_*/
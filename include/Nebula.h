@@ -56,6 +56,7 @@ class AuthManager;
 class DispatchManager;
 class FedReplicaManager;
 class HookLog;
+class QuotaLedger;
 class HookManager;
 class ImageManager;
 class InformationManager;
@@ -244,6 +245,11 @@ public:
         return hl;
     };
 
+    QuotaLedger * get_quota_ledger() const
+    {
+        return qledger;
+    };
+
     AuthManager * get_authm() const
     {
         return authm;
@@ -674,7 +680,7 @@ public:
 #ifdef GRPC
         , rm_grpc(0)
 #endif
-        , hm(0), hl(0), authm(0), aclm(0), imagem(0), marketm(0), ipamm(0)
+        , hm(0), hl(0), qledger(0), authm(0), aclm(0), imagem(0), marketm(0), ipamm(0)
         , raftm(0), frm(0), sam(0), sm(0), planm(0)
     {
     };
@@ -767,6 +773,7 @@ private:
 #endif
     HookManager *           hm;
     HookLog *               hl;
+    QuotaLedger *           qledger;
     AuthManager *           authm;
     AclManager *            aclm;
     ImageManager *          imagem;
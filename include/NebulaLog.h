@@ -18,6 +18,7 @@
 #define _NEBULA_LOG_H_
 
 #include "Log.h"
+#include "LogWriter.h"
 
 #include <sstream>
 #include <syslog.h>
@@ -41,15 +42,30 @@ public:
     // Logging
     // ---------------------------------------------------------------
 
+    /**
+     *  Initializes the log system
+     *    @param buffer_size if > 0, file logs are written by a separate thread
+     *    that buffers up to buffer_size lines
+     *    @param overflow policy when the buffer is full
+     */
     static void init_log_system(
             LogType                 ltype,
             Log::MessageType        clevel,
             const char *            filename,
             std::ios_base::openmode mode,
-            const std::string&      daemon)
+            const std::string&      daemon,
+            size_t                  buffer_size = 0,
+            LogWriter::Overflow     overflow    = LogWriter::BLOCK)
     {
         _log_type = ltype;
 
+        if ( buffer_size > 0 && (ltype == FILE || ltype == FILE_TS) )
+        {
+            writer = new LogWriter(filename, buffer_size, overflow);
+
+            FileLog::set_writer(writer);
+        }
+
         switch(ltype)
         {
             case FILE:
@@ -87,9 +103,29 @@ public:
         return UNDEFINED;
     }
 
+    /**
+     *  Writes the buffered lines and stops the writer thread, if any. Lines
+     *  logged afterwards are written synchronously.
+     */
+    static void flush_log_system()
+    {
+        if ( writer != nullptr )
+        {
+            FileLog::set_writer(nullptr);
+
+            writer->finalize();
+        }
+    }
+
     static void finalize_log_system()
     {
+        flush_log_system();
+
         delete logger;
+
+        delete writer;
+
+        writer = nullptr;
     }
 
     static void log(
@@ -166,8 +202,9 @@ private:
 
     ~NebulaLog() {};
 
-    static LogType _log_type;
-    static Log *   logger;
+    static LogType     _log_type;
+    static Log *       logger;
+    static LogWriter * writer;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -57,6 +57,13 @@ public:
     NebulaLog::LogType get_log_system(
             NebulaLog::LogType default_ = NebulaLog::UNDEFINED) const;
 
+    /**
+     *  Returns the value of LOG->BUFFER_SIZE and LOG->OVERFLOW in oned.conf
+     *      @param overflow policy when the log buffer is full
+     *      @return the number of buffered lines, 0 to write synchronously
+     */
+    size_t get_log_buffer(LogWriter::Overflow& overflow) const;
+
     /**
      *  Returns the value of ONE_LOCATION env variable. When this variable is
      *  not defined the nebula location is "/".
@@ -62,8 +62,17 @@ public:
     {
         xmlXPathObjectPtr obj;
 
-        xmlNodePtr cur;
-        xmlChar *  str_ptr;
+        std::vector<xmlNodePtr> nodes;
+
+        if (path_nodes(expr, nodes))
+        {
+            for (auto node : nodes)
+            {
+                node_value(node, values);
+            }
+
+            return;
+        }
 
         obj = xmlXPathEvalExpression(reinterpret_cast<const xmlChar *>(expr), ctx);
 
@@ -86,29 +95,7 @@ public:
 
                 for (int i = 0; i < obj->nodesetval->nodeNr ; ++i)
                 {
-                    cur = obj->nodesetval->nodeTab[i];
-
-                    if ( cur == 0 || cur->type != XML_ELEMENT_NODE )
-                    {
-                        continue;
-                    }
-
-                    str_ptr = xmlNodeGetContent(cur);
-
-                    if (str_ptr != 0)
-                    {
-                        std::istringstream iss(reinterpret_cast<char *>(str_ptr));
-                        T val;
-
-                        iss >> std::dec >> val;
-
-                        if (!iss.fail())
-                        {
-                            values.push_back(val);
-                        }
-
-                        xmlFree(str_ptr);
-                    }
+                    node_value(obj->nodesetval->nodeTab[i], values);
                 }
                 break;
 
@@ -388,6 +375,48 @@ private:
      */
     void xml_parse(const std::string &xml_doc);
 
+    /**
+     *  Gets the nodes of a simple absolute path (e.g. /VM/TEMPLATE/DISK) by
+     *  walking the document tree. This is much faster than compiling and
+     *  evaluating the equivalent XPath expression.
+     *    @param expr the path
+     *    @param nodes the element nodes of the path, in document order
+     *
+     *    @return false if expr is not a simple path, it needs to be evaluated
+     *    as a XPath expression
+     */
+    bool path_nodes(const char * expr, std::vector<xmlNodePtr>& nodes) const;
+
+    /**
+     *  Adds the content of an element node to values, if it can be converted
+     *  to T
+     */
+    template<typename T>
+    static void node_value(xmlNodePtr node, std::vector<T>& values)
+    {
+        if ( node == 0 || node->type != XML_ELEMENT_NODE )
+        {
+            return;
+        }
+
+        xmlChar * str_ptr = xmlNodeGetContent(node);
+
+        if (str_ptr != 0)
+        {
+            std::istringstream iss(reinterpret_cast<char *>(str_ptr));
+            T val;
+
+            iss >> std::dec >> val;
+
+            if (!iss.fail())
+            {
+                values.push_back(val);
+            }
+
+            xmlFree(str_ptr);
+        }
+    }
+
     /**
      *  Search the Object for a given attribute in a set of object specific
      *  routes.
@@ -139,6 +139,12 @@ namespace one_db
 
     extern const char * history_db_bootstrap;
 
+    extern const char * history_acct_table;
+
+    extern const char * history_acct_db_names;
+
+    extern const char * history_acct_db_bootstrap;
+
     /* ---------------------------------------------------------------------- */
     /* Hook tables                                                            */
     /* ---------------------------------------------------------------------- */
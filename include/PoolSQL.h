@@ -438,12 +438,15 @@ protected:
      *   @param oss The output stream to dump the xml contents
      *   @param root_elem_name Name of the root xml element name
      *   @param sql_query The SQL query to execute
+     *   @param stream rows are streamed from the DB as they are read, use it
+     *   for large (unbounded) result sets to limit peak memory
      *
      *   @return 0 on success
      */
     int dump(std::string&        oss,
              const std::string&  root_elem_name,
-             std::ostringstream& sql_query);
+             std::ostringstream& sql_query,
+             bool                stream = false);
 
     /* ---------------------------------------------------------------------- */
     /* Interface to access the lastOID assigned by the pool                   */
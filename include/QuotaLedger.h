@@ -0,0 +1,162 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+
+#ifndef QUOTA_LEDGER_H_
+#define QUOTA_LEDGER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Quotas.h"
+
+class Template;
+
+/**
+ *  The QuotaLedger keeps the quotas of users and groups in memory, so quota
+ *  checks do not read them from the DB. Quota updates are written to the DB
+ *  before they are stored in the ledger (write-through), so the DB always
+ *  holds the current usage and the ledger does not need to be rebuilt after
+ *  a crash or a leader change.
+ *
+ *  The ledger also keeps the quota reservations of multi-VM requests, see
+ *  reserve(), commit() and rollback(). A reservation updates the user and
+ *  group quotas once for all the objects of the request.
+ */
+class QuotaLedger
+{
+public:
+    QuotaLedger() = default;
+
+    ~QuotaLedger() = default;
+
+    /**
+     *  Activates the ledger, it should be called when the server becomes the
+     *  leader (or starts in solo mode). Quotas are loaded from the DB as they
+     *  are used.
+     */
+    void start();
+
+    /**
+     *  Deactivates the ledger, when the server is no longer the leader.
+     *  Quotas are read from the DB, updated by log replication.
+     */
+    void stop();
+
+    /**
+     *  Gets the quotas of a user/group from the ledger
+     *    @param table of the quotas (user or group quotas)
+     *    @param oid of the user/group
+     *    @param xml the quotas body
+     *    @return true if the quotas are in the ledger
+     */
+    bool get(const char * table, int oid, std::string& xml);
+
+    /**
+     *  Stores the quotas of a user/group in the ledger, once they are read
+     *  from or written to the DB
+     *    @param table of the quotas (user or group quotas)
+     *    @param oid of the user/group
+     *    @param xml the quotas body
+     *    @param replace false to keep the quotas already in the ledger, when
+     *    they are read from the DB without the object lock
+     */
+    void put(const char * table, int oid, const std::string& xml,
+             bool replace);
+
+    /**
+     *  Removes the quotas of a user/group from the ledger
+     */
+    void erase(const char * table, int oid);
+
+    // -------------------------------------------------------------------------
+    // Quota reservations
+    // -------------------------------------------------------------------------
+    /**
+     *  Reserves the quota usage of n objects for a user and group. The
+     *  reservation is checked against the cluster quotas of the template
+     *  CLUSTER_ID (if any) and the global quotas.
+     *    @param uid of the user, -1 or oneadmin to skip the user quotas
+     *    @param gid of the group, -1 or oneadmin to skip the group quotas
+     *    @param type of the quota
+     *    @param tmpl with the usage of one object
+     *    @param n number of objects
+     *    @param error string describing the error
+     *
+     *    @return the reservation id, -1 if the quota limits are exceeded or
+     *    the user or group does not exist
+     */
+    int reserve(int uid, int gid, Quotas::QuotaType type, Template * tmpl,
+                int n, std::string& error);
+
+    /**
+     *  Commits the usage of n objects of a reservation, the usage is now
+     *  accounted by the objects. The reservation is removed once all of its
+     *  objects are committed.
+     */
+    void commit(int rid, int n = 1);
+
+    /**
+     *  Releases the usage of the objects not committed and removes the
+     *  reservation
+     */
+    void rollback(int rid);
+
+private:
+    struct Reservation
+    {
+        int uid;
+        int gid;
+
+        Quotas::QuotaType type;
+
+        std::unique_ptr<Template> tmpl;
+
+        int count;
+    };
+
+    /**
+     *  Ledger is only used when this server is the leader
+     */
+    bool active = false;
+
+    /**
+     *  Protects the entries and reservations of the ledger
+     */
+    std::mutex ledger_mutex;
+
+    /**
+     *  Quotas body indexed by <table, oid>
+     */
+    std::map<std::pair<std::string, int>, std::string> entries;
+
+    /**
+     *  Pending reservations indexed by id
+     */
+    std::map<int, Reservation> reservations;
+
+    int next_rid = 0;
+
+    /**
+     *  Checks the quotas of n objects, usage is not updated on failure
+     */
+    static bool check(Quotas& quota, Quotas::QuotaType type, Template * tmpl,
+                      int n, Quotas& default_quotas, std::string& error);
+};
+
+#endif /*QUOTA_LEDGER_H_*/
@@ -113,11 +113,7 @@ private:
      *    @param db pointer to the db
      *    @return 0 on success
      */
-    int update(SqlDB *db) override
-    {
-        std::string error_str;
-        return insert_replace(db, true, error_str);
-    }
+    int update(SqlDB *db) override;
 
     /**
      *  Callback function to read a Quotas object (Quotas::select)
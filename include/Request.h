@@ -23,6 +23,7 @@
 #include "PoolObjectSQL.h"
 #include "RequestAttributes.h"
 #include "HookAPI.h"
+#include "Metrics.h"
 
 /**
  *  The Request Class represents the basic abstraction for the OpenNebula
@@ -124,6 +125,17 @@ public:
     }
 
 protected:
+    /**
+     *  Records the time spent in a phase of the call (authentication,
+     *  forward, execution or total) in the one_rpc_seconds metric
+     */
+    void observe_phase(const char * phase,
+                       const LatencyHistogram::clock::time_point& start) const
+    {
+        Metrics::instance().histogram("one_rpc_seconds", "method=\"" +
+                _method_name + "\",phase=\"" + phase + "\"").observe(start);
+    }
+
     /* ---------------------------------------------------------------------- */
     /* Global configuration attributes for API calls                          */
     /* ---------------------------------------------------------------------- */
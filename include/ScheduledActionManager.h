@@ -32,7 +32,12 @@ class VirtualMachinePool;
 class ScheduledActionManager
 {
 public:
-    ScheduledActionManager(time_t timer, int max_backups, int max_backups_host);
+    ScheduledActionManager(time_t timer,
+                           int max_backups,
+                           int max_backups_host,
+                           int max_backups_ds,
+                           long long max_backups_ds_size,
+                           long long backup_ds_rate);
 
     void finalize();
 
@@ -47,8 +52,20 @@ private:
 
     VirtualMachinePool *vm_pool;
 
+    /*
+     * Period to scan for backup state (active backups and Backup Jobs).
+     * Scheduled actions are checked every second from the due-time index
+     */
+    time_t _timer_period;
+
+    time_t last_backup_scan = 0;
+
     int _max_backups;
     int _max_backups_host;
+    int _max_backups_ds;
+
+    long long _max_backups_ds_size; // MB
+    long long _backup_ds_rate;      // MB/s
 
     int active_backups;
 
@@ -57,11 +74,36 @@ private:
      */
     std::map<int, int> host_backups;
 
+    /*
+     * Backups per backup datastore, active ones and the ones waiting for a
+     * free slot in the host or datastore. Sizes are estimated in MB.
+     */
+    struct DatastoreBackups
+    {
+        int       active = 0;
+        long long active_size = 0;
+
+        int       pending = 0;
+        long long pending_size = 0;
+    };
+
+    std::map<int, DatastoreBackups> ds_backups;
+
     /*
      * List of backups to run <sa_id, vm_id>
      */
     std::vector<std::pair<int, int>> vm_backups;
 
+    /*
+     * Due backup actions already seen, a new one triggers a backup scan
+     */
+    std::set<int> seen_backups;
+
+    /*
+     * Failed VM actions are retried every timer period <sa_id, retry_time>
+     */
+    std::map<int, time_t> failed_actions;
+
     // Periodically called method,
     void timer_action();
 
@@ -82,15 +124,41 @@ private:
 
     /*
      * Manages Backup Job scheduled actions
+     *   @return true if any Backup Job has been executed
      */
-    void scheduled_backup_jobs();
+    bool scheduled_backup_jobs();
 
     /*
      * Manages backups created by BackupJob
      */
     void backup_jobs();
 
-    void run_scheduled_action_vm(int vm_id, int sa_id, const std::string& aname);
+    /*
+     * Checks the backup limits of the host and target datastore of a VM
+     *   @param hid of the host running the VM
+     *   @param ds_id of the backup datastore
+     *   @param size estimated size of the backup (MB)
+     *   @param error describing the limit reached
+     *   @return true if the backup can be started
+     */
+    bool check_backup_limits(int hid, int ds_id, long long size, std::string& error);
+
+    /*
+     * Updates the host and datastore counters with a started backup
+     */
+    void add_backup(int hid, int ds_id, long long size);
+
+    /*
+     * Logs the predicted completion time of the backups of each datastore,
+     * based on the estimated size and BACKUP_DS_RATE
+     */
+    void log_backup_prediction();
+
+    /*
+     * Executes a VM scheduled action
+     *   @return 0 on success
+     */
+    int run_scheduled_action_vm(int vm_id, int sa_id, const std::string& aname);
 
     int vm_action_call(int vmid, int sa_id, std::string& error);
 };
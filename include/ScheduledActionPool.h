@@ -21,6 +21,8 @@
 #include "OneDB.h"
 #include "ScheduledAction.h"
 
+#include <mutex>
+
 class SqlDB;
 
 class ScheduledActionPool : public PoolSQL
@@ -40,6 +42,21 @@ public:
                  const VectorAttribute * va,
                  std::string& error_str);
 
+    /**
+     *  Updates the Scheduled Action in the DB and in the due-time index
+     *    @param objsql a pointer to the ScheduledAction
+     *    @return 0 on success
+     */
+    int update(PoolObjectSQL * objsql) override;
+
+    /**
+     *  Drops the Scheduled Action from the DB and from the due-time index
+     *    @param objsql a pointer to the ScheduledAction
+     *    @param error_msg Error reason, if any
+     *    @return 0 on success, -1 DB error
+     */
+    int drop(PoolObjectSQL * objsql, std::string& error_msg) override;
+
     /**
      *  Gets an object from the pool (if needed the object is loaded from the
      *  database). The object is locked, other threads can't access the same
@@ -109,11 +126,63 @@ public:
     }
 
     /*
-     * Return list of due actions <sched_id, resource_id> for specific object type
+     * Return list of due actions <sched_id, resource_id> for specific object
+     * type, ordered by time. Actions are read from the due-time index.
     */
     std::vector<std::pair<int, int>> get_is_due_actions(PoolObjectSQL::ObjectType ot);
 
+    /**
+     *  Discards the due-time index, it will be reloaded from the DB on next
+     *  access. Used by followers as the table is updated by log replication.
+     */
+    void invalidate_index()
+    {
+        std::lock_guard<std::mutex> lock(index_mutex);
+
+        index_valid = false;
+
+        index_entries.clear();
+        index_queue.clear();
+    }
+
     int drop_sched_actions(const std::vector<int>& sa_ids);
+
+private:
+    /**
+     *  Entry in the due-time index. Only pending actions (time > done) are
+     *  stored in the queue
+     */
+    struct IndexEntry
+    {
+        PoolObjectSQL::ObjectType type;
+        int    parent_id;
+        time_t time;
+    };
+
+    std::mutex index_mutex;
+
+    bool index_valid = false;
+
+    /**
+     *  Pending actions by oid, and <time, oid> queue ordered by due time
+     */
+    std::map<int, IndexEntry> index_entries;
+
+    std::set<std::pair<time_t, int>> index_queue;
+
+    /**
+     *  Loads the pending actions from the DB, index_mutex MUST be locked
+     */
+    void load_index();
+
+    /**
+     *  Adds, updates or removes the action in the index according to its
+     *  time and done values
+     */
+    void index_set(int oid, PoolObjectSQL::ObjectType type, int parent_id,
+                   time_t time, time_t done);
+
+    void index_remove(int oid);
 };
 
 #endif
@@ -71,6 +71,19 @@ public:
      */
     void place_finished();
 
+    /**
+     *  Next placement request will include all the hosts. Used when this
+     *  server becomes the leader, as hosts may have been updated by other
+     *  leader since the last request.
+     */
+    void reset_delta()
+    {
+        if ( auto scheduler = get() )
+        {
+            scheduler->reset_delta();
+        }
+    }
+
 private:
     /**
      *  The timer action will periodically will check placement requests.
@@ -95,6 +108,11 @@ private:
 
     time_t retry_time;
 
+    /**
+     *  Send incremental HOST_POOL updates to the driver (SCHED_MAD/DELTA)
+     */
+    bool delta_input = false;
+
     /**
      *  Generic name for the Scheduler driver
      */
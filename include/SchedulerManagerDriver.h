@@ -22,6 +22,10 @@
 
 #include "NebulaLog.h"
 
+#include <atomic>
+#include <map>
+#include <mutex>
+
 struct SchedRequest;
 
 class VirtualMachinePool;
@@ -50,14 +54,38 @@ public:
 
     virtual ~SchedulerManagerDriver() = default;
 
-    void place() const;
+    /**
+     *  Sends a placement request to the scheduler
+     *    @param delta if true the HOST_POOL only includes the hosts changed
+     *    since the previous request, see host_pool_delta
+     */
+    void place(bool delta = false) const;
 
     void optimize(int cluster_id) const;
 
+    /**
+     *  Next placement request will include all the hosts. Used when the driver
+     *  cannot rebuild the HOST_POOL from the incremental updates.
+     */
+    void reset_delta() const
+    {
+        delta_reset = true;
+    }
+
+    /**
+     *  Failure message used by the driver to request a full HOST_POOL
+     */
+    static constexpr const char * delta_resync = "HOST_POOL_DELTA_RESYNC";
+
     void log_vm(int id, const std::string& msg) const;
 
     void log_cluster(int cluster_id, const std::string& msg) const;
 
+    /**
+     *  Logs the time spent in each phase of a scheduler request
+     */
+    void log_profile(const SchedRequest& sr, const std::string& request) const;
+
 protected:
     friend class SchedulerManager;
 
@@ -66,7 +94,20 @@ protected:
      *  scheduler.
      *    @return 0 on success
      */
-    int scheduler_message(SchedRequest& sr, std::ostringstream& oss) const;
+    int scheduler_message(SchedRequest& sr, std::ostringstream& oss,
+                          bool delta = false) const;
+
+    /**
+     *  Renders the HOST_POOL with the hosts changed since the previous request
+     *  and a HOST_POOL_DELTA element to rebuild the full pool in the driver:
+     *    <HOST_POOL_DELTA>
+     *      <SEQ>sequence number of the request</SEQ>
+     *      <FULL>1 if the HOST_POOL includes all the hosts</FULL>
+     *      <KEEP><ID>hosts not changed since the previous request</ID></KEEP>
+     *    </HOST_POOL_DELTA>
+     *  Hosts not included in the HOST_POOL or KEEP are removed by the driver.
+     */
+    void host_pool_delta(SchedRequest& sr, std::ostringstream& oss) const;
 
     /* ---------------------------------------------------------------------- */
     /* Match-making functions                                                 */
@@ -76,6 +117,14 @@ protected:
 
     int setup_optimize_pools(int cluster_id, SchedRequest& sr) const;
 
+    /**
+     *  Removes the hosts that cannot allocate any of the pending VMs, using
+     *  the host capacity snapshot. This avoids loading and rendering hosts
+     *  that the scheduler will never select.
+     *    @param sr, includes the set of VMs and hosts
+     */
+    void filter_host_capacity(SchedRequest& sr) const;
+
     /**
      *  Creates a match-making request.
      *    @param sr, includes the set of VMs and resources to generate the match-making
@@ -131,6 +180,15 @@ private:
     ClusterPool *clpool;
 
     VMGroupPool *vmgpool;
+
+    // Incremental HOST_POOL state: digest of the hosts sent to the driver
+    mutable std::mutex delta_mutex;
+
+    mutable std::map<int, size_t> sent_hosts;
+
+    mutable uint64_t delta_seq = 0;
+
+    mutable std::atomic<bool> delta_reset {true};
 };
 
 /* -------------------------------------------------------------------------- */
@@ -24,10 +24,15 @@
 #include "UserPool.h"
 #include "ClusterPool.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <tuple>
 
 /**
  *  This class represents a generic OpenNebula pool for structuring scheduling
@@ -158,6 +163,246 @@ public:
     }
 };
 
+/**
+ *  Evaluates requirement expressions on the objects of a SchedPool. The result
+ *  of each distinct expression is computed once per object, VMs created from
+ *  the same template share the same requirements.
+ *
+ *  Expressions can be evaluated in advance by several threads. Each thread
+ *  evaluates every expression on a disjoint set of objects, as the XPath
+ *  context of an object cannot be used concurrently. Objects are identified
+ *  by their position in the pool ids vector, that must not change after the
+ *  evaluation.
+ */
+template <typename P, typename O>
+class SchedRequirements
+{
+public:
+    SchedRequirements(SchedPool<P, O>& p):pool(p) {};
+
+    /**
+     *  Adds an expression to be evaluated by evaluate()
+     */
+    void add(const std::string& expr)
+    {
+        if (!expr.empty())
+        {
+            results.emplace(expr, Result());
+        }
+    }
+
+    /**
+     *  Evaluates the added expressions on all the objects of the pool
+     *    @param threads maximum number of threads to use
+     */
+    void evaluate(unsigned int threads)
+    {
+        std::vector<O *> objects;
+
+        for (int id : pool.ids)
+        {
+            objects.push_back(pool.get(id));
+        }
+
+        for (auto& r : results)
+        {
+            r.second.matched.assign(objects.size(), UNKNOWN);
+        }
+
+        size_t evals = objects.size() * results.size();
+
+        threads = std::max(1U, std::min<unsigned int>(threads,
+                                                      evals / MIN_THREAD_EVALS));
+
+        std::mutex error_mutex;
+
+        auto eval_range = [&](size_t start, size_t end)
+        {
+            for (auto& r : results)
+            {
+                for (size_t i = start; i < end; ++i)
+                {
+                    std::string error;
+
+                    r.second.matched[i] = eval(objects[i], r.first, error);
+
+                    if (r.second.matched[i] == ERROR)
+                    {
+                        std::lock_guard<std::mutex> lock(error_mutex);
+
+                        r.second.error = error;
+                    }
+                }
+            }
+        };
+
+        if (threads == 1)
+        {
+            eval_range(0, objects.size());
+            return;
+        }
+
+        std::vector<std::thread> workers;
+
+        size_t chunk = (objects.size() + threads - 1) / threads;
+
+        for (size_t start = 0; start < objects.size(); start += chunk)
+        {
+            workers.emplace_back(eval_range, start,
+                                 std::min(start + chunk, objects.size()));
+        }
+
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+    }
+
+    /**
+     *  Checks if an object matches an expression. Expressions not evaluated
+     *  in advance are evaluated and cached.
+     *    @param expr the requirements, empty expressions match any object
+     *    @param index of the object in the pool ids vector
+     *    @param error if the expression cannot be evaluated
+     *    @return 1 if the object matches, 0 if not, -1 on error
+     */
+    int test(const std::string& expr, size_t index, std::string& error)
+    {
+        if (expr.empty())
+        {
+            return 1;
+        }
+
+        Result& r = results[expr];
+
+        if (r.matched.size() != pool.ids.size())
+        {
+            r.matched.assign(pool.ids.size(), UNKNOWN);
+        }
+
+        if (r.matched[index] == UNKNOWN)
+        {
+            r.matched[index] = eval(pool.get(pool.ids[index]), expr, r.error);
+        }
+
+        switch (r.matched[index])
+        {
+            case MATCH:
+                return 1;
+
+            case ERROR:
+                error = r.error;
+                return -1;
+
+            default:
+                return 0;
+        }
+    }
+
+private:
+    enum : char
+    {
+        UNKNOWN  = -1,
+        NO_MATCH = 0,
+        MATCH    = 1,
+        ERROR    = 2
+    };
+
+    /**
+     *  Minimum number of evaluations to start a new thread
+     */
+    static constexpr size_t MIN_THREAD_EVALS = 2048;
+
+    struct Result
+    {
+        std::vector<char> matched;
+
+        std::string error;
+    };
+
+    SchedPool<P, O>& pool;
+
+    std::map<std::string, Result> results;
+
+    static char eval(O * obj, const std::string& expr, std::string& error)
+    {
+        char * estr;
+        bool   matched;
+
+        if (obj == nullptr)
+        {
+            return NO_MATCH;
+        }
+
+        if (obj->eval_bool(expr, matched, &estr) != 0)
+        {
+            error = estr;
+
+            free(estr);
+
+            return ERROR;
+        }
+
+        return matched ? MATCH : NO_MATCH;
+    }
+};
+
+/**
+ *  Time spent in the phases of a scheduler request
+ */
+class SchedProfile
+{
+public:
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    static time_point now()
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    /**
+     *  Adds the time elapsed since start to a phase
+     */
+    void add(const std::string& phase, const time_point& start)
+    {
+        double ms = std::chrono::duration<double, std::milli>(now() - start).count();
+
+        for (auto& p : phases)
+        {
+            if (p.first == phase)
+            {
+                p.second += ms;
+                return;
+            }
+        }
+
+        phases.emplace_back(phase, ms);
+    }
+
+    /**
+     *  @return string with the time of each phase in ms, in the order they
+     *  were added
+     */
+    std::string to_str() const
+    {
+        std::ostringstream oss;
+
+        oss.setf(std::ios::fixed);
+        oss.precision(2);
+
+        for (auto it = phases.begin(); it != phases.end(); ++it)
+        {
+            oss << (it == phases.begin() ? "" : ", ")
+                << it->first << ": " << it->second << "ms";
+        }
+
+        return oss.str();
+    }
+
+private:
+    std::vector<std::pair<std::string, double>> phases;
+};
+
 /**
  *  This class represents a the set of resource matches for scheduling VMs.
  *  A match consists of:
@@ -395,6 +640,14 @@ struct SchedRequest
 
     SchedMatch match;
 
+    SchedProfile profile;
+
+    /**
+     *  Authorization results of the request, by (uid, object type, object id,
+     *  operation). The group set is the one of the user.
+     */
+    std::map<std::tuple<int, int, int, int>, int> auth_cache;
+
     void merge_cluster_to_host()
     {
         std::map<int, std::string> cluster_templates;
@@ -164,6 +164,14 @@ public:
         return updating.del(id);
     }
 
+    /**
+     *  @return number of VMs with a rule update in progress at the hosts
+     */
+    int get_updating() const
+    {
+        return updating.size();
+    }
+
     int add_error(int id)
     {
         return error.add(id);
@@ -43,7 +43,8 @@ public:
         DriverManager(_mad_location),
         Listener("Transfer Manager"),
         vmpool(_vmpool),
-        hpool(_hpool)
+        hpool(_hpool),
+        inline_scripts(false)
     {
     };
 
@@ -198,11 +199,34 @@ private:
      */
     HostPool *              hpool;
 
+    /**
+     *  Send the transfer scripts in the driver message (compressed) instead
+     *  of writing them to the VM directory (TM_MAD/INLINE_SCRIPTS)
+     */
+    bool inline_scripts;
+
+    /**
+     *  Prefix of TRANSFER payloads that embed the script
+     */
+    static const char * inline_prefix;
+
     /**
      *  Generic name for the TransferManager driver
      */
     static const char *  transfer_driver_name;
 
+    /**
+     *  Gets the payload of a TRANSFER message for a script. The script is
+     *  written to its transfer file unless it is sent inline, inline scripts
+     *  are also written when the log level is DDEBUG.
+     *    @param xfr_name path of the transfer file, on success it is set to
+     *    the payload of the message (the path or the encoded script)
+     *    @param xfr the transfer script
+     *
+     *    @return 0 on success, -1 if the transfer file could not be written
+     */
+    int transfer_payload(std::string& xfr_name, const std::ostringstream& xfr);
+
     /**
      *  Returns a pointer to a Transfer Manager driver. The driver is
      *  searched by its name.
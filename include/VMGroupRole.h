@@ -130,6 +130,18 @@ public:
      */
     void role_requirements(VMGroupPolicy p, std::string& requirements);
 
+    /**
+     *  Gets the affined HOSTS of the role
+     *    @param hosts set of host IDs
+     */
+    void affined_hosts(std::set<int>& hosts) const;
+
+    /**
+     *  Gets the antiaffined HOSTS of the role
+     *    @param hosts set of host IDs
+     */
+    void antiaffined_hosts(std::set<int>& hosts) const;
+
     /**
      *  Gets the placement requirements for the affined HOSTS
      *    @param reqs string with the requirements expression
@@ -749,6 +749,8 @@ public:
         load_monitoring();
 
         to_xml_extended(history->vm_info, 0, false);
+
+        set_history_acct(history.get());
     };
 
     /**
@@ -757,6 +759,8 @@ public:
     void set_previous_vm_info()
     {
         to_xml_extended(previous_history->vm_info, 0, false);
+
+        set_history_acct(previous_history.get());
     };
 
     /**
@@ -2057,6 +2061,12 @@ private:
      */
     int insert_replace(SqlDB *db, bool replace, std::string& error_str);
 
+    /**
+     *  Sets the accounting data (owner and capacity) of a history record
+     *    @param h the history record
+     */
+    void set_history_acct(History * h);
+
     /**
      *  Updates the VM history record
      *    @param db pointer to the db
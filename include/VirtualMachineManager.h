@@ -63,6 +63,28 @@ public:
      */
     int updatesg(VirtualMachine * vm, int sgid);
 
+    /**
+     * Builds the driver data to update the firewall rules of a VM
+     *   @param vm pointer to VM, needs to be locked
+     *   @param sgid the id of the security group
+     *   @param drv_msg the driver data for the VM
+     *
+     *   @return 0 on success
+     */
+    int updatesg_data(VirtualMachine * vm, int sgid, std::string& drv_msg);
+
+    /**
+     * Updates firewall rules of a set of VMs running in the same host, with a
+     * single driver action. The driver replies for each VM.
+     *   @param vmm_mad name of the VMM driver of the host
+     *   @param sgid the id of the security group
+     *   @param vms VM IDs and driver data (see updatesg_data)
+     *
+     *   @return 0 on success
+     */
+    int updatesg(const std::string& vmm_mad, int sgid,
+                 const std::vector<std::pair<int, std::string>>& vms);
+
     /**
      * Updates nic attributes of a VM
      *   @param vm pointer to VM, needs to be locked
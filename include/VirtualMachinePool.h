@@ -20,7 +20,11 @@
 #include "PoolSQL.h"
 #include "VirtualMachine.h"
 #include "OneDB.h"
+#include "Listener.h"
 
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <time.h>
 
 /**
@@ -39,7 +43,18 @@ public:
                        float                        default_disk_cost,
                        bool                         showback_only_running);
 
-    ~VirtualMachinePool() {};
+    ~VirtualMachinePool();
+
+    /**
+     *  Aggregation criteria for the accounting totals
+     */
+    enum AcctGroupBy
+    {
+        ACCT_USER    = 0,
+        ACCT_GROUP   = 1,
+        ACCT_HOST    = 2,
+        ACCT_CLUSTER = 3
+    };
 
     /**
      *  Function to allocate a new VM object
@@ -208,7 +223,14 @@ public:
     int update_history(
             VirtualMachine * vm)
     {
-        return vm->update_history(db);
+        int rc = vm->update_history(db);
+
+        if ( rc == 0 )
+        {
+            set_vm_state(vm, true);
+        }
+
+        return rc;
     }
 
     /**
@@ -233,6 +255,107 @@ public:
         return vm->update_search(db);
     }
 
+    /**
+     *  Schedules the update of the VM's search information. Updates are
+     *  coalesced and written by a background thread every second
+     *    @param oid of the virtual machine
+     */
+    void update_search_async(int oid)
+    {
+        std::lock_guard<std::mutex> lock(search_mutex);
+
+        search_pending.insert(oid);
+    }
+
+    /**
+     *  Schedules the update of the search information of all the VMs not in
+     *  DONE state. It is called when the server becomes the leader (or starts
+     *  in solo mode), as updates pending on a former leader are lost.
+     */
+    void rebuild_search();
+
+    /**
+     *  Drops the pending search updates, when the server is no longer the
+     *  leader. The new leader rebuilds them.
+     */
+    void clear_search()
+    {
+        std::lock_guard<std::mutex> lock(search_mutex);
+
+        search_pending.clear();
+    }
+
+    /**
+     *  Stops the search indexer and writes the pending updates. It should be
+     *  called before the Raft manager is finalized.
+     */
+    void finalize_search();
+
+    //--------------------------------------------------------------------------
+    // VM state table, used to filter monitor state reports
+    //--------------------------------------------------------------------------
+    /**
+     *  Compact state of a VM as of its last DB write
+     *    - hid, host of the current history record (-1 if none)
+     *    - stime, etime of the running period in the current history record
+     *    - info, last time the history record was updated
+     */
+    struct VmStateEntry
+    {
+        VirtualMachine::VmState  state;
+        VirtualMachine::LcmState lcm_state;
+
+        int hid;
+
+        time_t stime;
+        time_t etime;
+
+        time_t info;
+
+        std::string deploy_id;
+    };
+
+    /**
+     *  Updates the state table entry of a VM, the vm's mutex SHOULD be locked.
+     *  It is called whenever the VM or its history record is written to DB.
+     *    @param vm pointer to the virtual machine object
+     *    @param info true if the history record (VM info) has been updated
+     */
+    void set_vm_state(VirtualMachine * vm, bool info = false);
+
+    /**
+     *  Gets the state of a VM without loading the object
+     *    @param oid of the VM
+     *    @param vms state of the VM
+     *    @return true if the VM is in the table
+     */
+    bool get_vm_state(int oid, VmStateEntry& vms)
+    {
+        std::lock_guard<std::mutex> lock(states_mutex);
+
+        auto it = vm_states.find(oid);
+
+        if ( it == vm_states.end() )
+        {
+            return false;
+        }
+
+        vms = it->second;
+
+        return true;
+    }
+
+    /**
+     *  Removes all the entries of the state table. It is called on Raft
+     *  state changes, as VMs may have been updated by other leader.
+     */
+    void clear_vm_states()
+    {
+        std::lock_guard<std::mutex> lock(states_mutex);
+
+        vm_states.clear();
+    }
+
     /**
      *  Bootstraps the database table(s) associated to the VirtualMachine pool
      *    @return 0 on success
@@ -304,6 +427,8 @@ public:
      *  @param time_end end date to include history record
      *  @param sid first element used for pagination
      *  @param rows number of records to retrieve, -1 to disable
+     *  @param part only include records of VMs with vid % num_parts == part
+     *  @param num_parts number of partitions, 1 to disable
      *
      *  @return 0 on success
      */
@@ -311,7 +436,28 @@ public:
                   int                time_start,
                   int                time_end,
                   int                sid = 0,
-                  int                rows = -1);
+                  int                rows = -1,
+                  int                part = 0,
+                  int                num_parts = 1);
+    /**
+     *  Dumps the VM accounting totals aggregated by user, group, host or
+     *  cluster in XML format. Totals are computed by the DB from the numeric
+     *  history_acct table, history record bodies are not read. The table
+     *  only includes closed history records.
+     *  @param oss the output stream to dump the totals
+     *  @param where filter for the VMs, defaults to all
+     *  @param group_by aggregation criteria
+     *  @param time_start start of the time window, -1 to unset
+     *  @param time_end end of the time window, -1 for now
+     *
+     *  @return 0 on success
+     */
+    int dump_acct_totals(std::string&       oss,
+                         const std::string& where,
+                         AcctGroupBy        group_by,
+                         time_t             time_start,
+                         time_t             time_end);
+
     /**
      *  Dumps the VM showback information in XML format. A filter can be also
      *  added to the query as well as a time frame.
@@ -382,7 +528,9 @@ public:
 
     /**
      * Processes all the history records, and stores the monthly cost for each
-     * VM
+     * VM. When no start date is given only the months since the last complete
+     * run (showback watermark) are computed. History records are processed in
+     * parallel, partitioned by VM id.
      *  @param start_month First month (+year) to process. January is 1.
      *  Use -1 to unset
      *  @param start_year First year (+month) to process. e.g. 2014.
@@ -450,6 +598,34 @@ private:
      * note: datastore cost is always counted in poweroff and suspended state
      */
     bool _showback_only_running;
+
+    /**
+     *  VMs with outdated search information (body_json)
+     */
+    std::set<int> search_pending;
+
+    std::mutex search_mutex;
+
+    Timer search_timer;
+
+    /**
+     *  Max number of VMs updated by each run of the indexer, so a rebuild
+     *  does not flood the Raft log
+     */
+    static const size_t search_batch;
+
+    /**
+     *  Updates the search information of the pending VMs
+     *    @param max_vms number of VMs to update
+     */
+    void search_indexer(size_t max_vms);
+
+    /**
+     *  State of the VMs written by this server, DONE VMs are removed
+     */
+    std::unordered_map<int, VmStateEntry> vm_states;
+
+    std::mutex states_mutex;
 };
 
 #endif /*VIRTUAL_MACHINE_POOL_H_*/
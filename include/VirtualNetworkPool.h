@@ -19,6 +19,7 @@
 
 #include "PoolSQL.h"
 #include "VirtualNetwork.h"
+#include "AddressRange.h"
 #include "BitMap.h"
 #include "OneDB.h"
 
@@ -355,6 +356,16 @@ private:
      */
     static constexpr const char * vlan_table = "network_vlan_bitmap";
 
+    /**
+     *  VLAN_ID and global MAC bitmaps. They are kept across allocations and
+     *  only decoded again if changed in the DB. Protected by bitmap_mutex
+     */
+    std::mutex bitmap_mutex;
+
+    BitMap<4096> vlan_bitmap;
+
+    BitMap<AddressRange::MAC_GLOBAL_SIZE> mac_bitmap;
+
     //--------------------------------------------------------------------------
     // NIC Attribute build functions
     //--------------------------------------------------------------------------
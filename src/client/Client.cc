@@ -16,6 +16,7 @@
 
 #include "Client.h"
 #include "ClientXRPC.h"
+#include "ClientPeers.h"
 #include "NebulaLog.h"
 
 #include <pwd.h>
@@ -151,17 +152,82 @@ int Client::fed_replicate(const std::string& endpoint,
         return -1;
     }
 
+    ClientPeers& peers = ClientPeers::instance();
+    ClientPeers::time_point start;
+
+    if (!peers.start_call(endpoint, start, error_msg))
+    {
+        return -1;
+    }
+
+    int rc;
+
 #ifdef GRPC
+    if (is_grpc(endpoint))
+    {
+        rc = ClientGRPC::fed_replicate(endpoint, secret, index, prev_index, sql, timeout_ms,
+                                       success, last, error_msg);
+    }
+    else
+#endif
+    {
+        rc = ClientXRPC::fed_replicate(endpoint, secret, index, prev_index, sql, timeout_ms,
+                                       success, last, error_msg);
+    }
+
+    peers.end_call(endpoint, start, rc == 0);
+
+    return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int Client::fed_replicate_batch(const std::string& endpoint,
+                                uint64_t prev_index,
+                                const std::vector<uint64_t>& indexes,
+                                const std::vector<std::string>& sqls,
+                                time_t timeout_ms,
+                                bool& success,
+                                uint64_t& last,
+                                std::string& error_msg)
+{
+    string secret;
+
+    if ( Client::read_oneauth(secret, error_msg) == -1 )
+    {
+        return -1;
+    }
+
+    ClientPeers& peers = ClientPeers::instance();
+    ClientPeers::time_point start;
+
+    if (!peers.start_call(endpoint, start, error_msg))
+    {
+        return -1;
+    }
+
+    int rc;
 
+#ifdef GRPC
     if (is_grpc(endpoint))
     {
-        return ClientGRPC::fed_replicate(endpoint, secret, index, prev_index, sql, timeout_ms,
-                                         success, last, error_msg);
+        rc = ClientGRPC::fed_replicate_batch(endpoint, secret, prev_index,
+                                             indexes, sqls, timeout_ms,
+                                             success, last, error_msg);
     }
+    else
 #endif
+    {
+        rc = ClientXRPC::fed_replicate_batch(endpoint, secret, prev_index,
+                                             indexes, sqls, timeout_ms,
+                                             success, last, error_msg);
+    }
 
-    return ClientXRPC::fed_replicate(endpoint, secret, index, prev_index, sql, timeout_ms,
-                                         success, last, error_msg);
+    // The peer answered a call to a method it does not implement
+    peers.end_call(endpoint, start, rc != -1);
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -182,16 +248,32 @@ int Client::replicate(const std::string& endpoint,
         return -1;
     }
 
+    ClientPeers& peers = ClientPeers::instance();
+    ClientPeers::time_point start;
+
+    if (!peers.start_call(endpoint, start, error_msg))
+    {
+        return -1;
+    }
+
+    int rc;
+
 #ifdef GRPC
     if (is_grpc(endpoint))
     {
-        return ClientGRPC::replicate(endpoint, secret, params, sql, timeout_ms,
-                                     success, follower_term, error_msg);
+        rc = ClientGRPC::replicate(endpoint, secret, params, sql, timeout_ms,
+                                   success, follower_term, error_msg);
     }
+    else
 #endif
+    {
+        rc = ClientXRPC::replicate(endpoint, secret, params, sql, timeout_ms,
+                                   success, follower_term, error_msg);
+    }
+
+    peers.end_call(endpoint, start, rc == 0);
 
-    return ClientXRPC::replicate(endpoint, secret, params, sql, timeout_ms,
-                                     success, follower_term, error_msg);
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -214,14 +296,30 @@ int Client::vote_request(const std::string& endpoint,
         return -1;
     }
 
+    ClientPeers& peers = ClientPeers::instance();
+    ClientPeers::time_point start;
+
+    if (!peers.start_call(endpoint, start, error_msg))
+    {
+        return -1;
+    }
+
+    int rc;
+
 #ifdef GRPC
     if (is_grpc(endpoint))
     {
-        return ClientGRPC::vote_request(endpoint, secret, term, candidate_id, log_index, log_term,
-                                        timeout_ms, success, follower_term, error_msg);
+        rc = ClientGRPC::vote_request(endpoint, secret, term, candidate_id, log_index, log_term,
+                                      timeout_ms, success, follower_term, error_msg);
     }
+    else
 #endif
+    {
+        rc = ClientXRPC::vote_request(endpoint, secret, term, candidate_id, log_index, log_term,
+                                      timeout_ms, success, follower_term, error_msg);
+    }
+
+    peers.end_call(endpoint, start, rc == 0);
 
-    return ClientXRPC::vote_request(endpoint, secret, term, candidate_id, log_index, log_term,
-                                        timeout_ms, success, follower_term, error_msg);
+    return rc;
 }
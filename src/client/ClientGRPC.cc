@@ -21,8 +21,49 @@
 #include "user.grpc.pb.h"
 #include "zone.grpc.pb.h"
 
+#include <climits>
+
 using namespace std;
 
+map<string, shared_ptr<grpc::Channel>> ClientGRPC::peer_channels;
+
+mutex ClientGRPC::peer_mutex;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+shared_ptr<grpc::Channel> ClientGRPC::peer_channel(const string& endpoint)
+{
+    lock_guard<mutex> lock(peer_mutex);
+
+    auto it = peer_channels.find(endpoint);
+
+    if ( it != peer_channels.end() )
+    {
+        return it->second;
+    }
+
+    grpc::ChannelArguments args;
+
+    // Do not close idle connections, replication calls are sent on every
+    // heartbeat. Keepalive pings are only sent during calls.
+    args.SetInt(GRPC_ARG_CLIENT_IDLE_TIMEOUT_MS, INT_MAX);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, 30000);
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 5000);
+
+    args.SetInt(GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS, 100);
+    args.SetInt(GRPC_ARG_MIN_RECONNECT_BACKOFF_MS, 100);
+    args.SetInt(GRPC_ARG_MAX_RECONNECT_BACKOFF_MS, 2000);
+
+    auto ch = grpc::CreateCustomChannel(endpoint,
+                                        grpc::InsecureChannelCredentials(),
+                                        args);
+
+    peer_channels.emplace(endpoint, ch);
+
+    return ch;
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -397,15 +438,14 @@ int ClientGRPC::fed_replicate(const std::string& endpoint,
                               uint64_t& last,
                               std::string& error_msg)
 {
-    // todo: set timeout
-    // Creating channel is expensive operation, consider caching channels
-    auto ch = grpc::CreateChannel(endpoint, grpc::InsecureChannelCredentials());
-    auto stub = one::zone::ZoneService::NewStub(ch);
+    auto stub = one::zone::ZoneService::NewStub(peer_channel(endpoint));
 
     grpc::ClientContext context;
     one::zone::ReplicateFedLogRequest request;
     one::zone::ResponseReplicateFedLog response;
 
+    set_deadline(context, timeout_ms);
+
     request.set_session_id(secret);
     request.set_index(index);
     request.set_prev(prev_index);
@@ -429,6 +469,60 @@ int ClientGRPC::fed_replicate(const std::string& endpoint,
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+int ClientGRPC::fed_replicate_batch(const std::string& endpoint,
+                                    const std::string& secret,
+                                    uint64_t prev_index,
+                                    const std::vector<uint64_t>& indexes,
+                                    const std::vector<std::string>& sqls,
+                                    time_t timeout_ms,
+                                    bool& success,
+                                    uint64_t& last,
+                                    std::string& error_msg)
+{
+    auto stub = one::zone::ZoneService::NewStub(peer_channel(endpoint));
+
+    grpc::ClientContext context;
+    one::zone::ReplicateFedLogBatchRequest request;
+    one::zone::ResponseReplicateFedLog response;
+
+    set_deadline(context, timeout_ms);
+
+    request.set_session_id(secret);
+    request.set_prev(prev_index);
+
+    for (auto idx : indexes)
+    {
+        request.add_index(idx);
+    }
+
+    for (const auto& sql : sqls)
+    {
+        request.add_sql(sql);
+    }
+
+    auto status = stub->ReplicateFedLogBatch(&context, request, &response);
+
+    if (!status.ok())
+    {
+        error_msg = status.error_message();
+
+        if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED)
+        {
+            return -2;
+        }
+
+        return -1;
+    }
+
+    success = response.success();
+    last = response.index();
+
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 int ClientGRPC::replicate(const std::string& endpoint,
                           const std::string& secret,
                           const replicate_params& params,
@@ -438,14 +532,14 @@ int ClientGRPC::replicate(const std::string& endpoint,
                           uint32_t& follower_term,
                           std::string& error_msg)
 {
-    // todo: set timeout
-    auto ch = grpc::CreateChannel(endpoint, grpc::InsecureChannelCredentials());
-    auto stub = one::zone::ZoneService::NewStub(ch);
+    auto stub = one::zone::ZoneService::NewStub(peer_channel(endpoint));
 
     grpc::ClientContext context;
     one::zone::ReplicateLogRequest request;
     one::zone::ResponseReplicateLog response;
 
+    set_deadline(context, timeout_ms);
+
     request.set_session_id(secret);
     request.set_leader_id(params.leader_id);
     request.set_leader_commit(params.leader_commit);
@@ -486,14 +580,14 @@ int ClientGRPC::vote_request(const std::string& endpoint,
                              uint32_t& follower_term,
                              std::string& error_msg)
 {
-    // todo: set timeout
-    auto ch = grpc::CreateChannel(endpoint, grpc::InsecureChannelCredentials());
-    auto stub = one::zone::ZoneService::NewStub(ch);
+    auto stub = one::zone::ZoneService::NewStub(peer_channel(endpoint));
 
     grpc::ClientContext context;
     one::zone::VoteRequest request;
     one::zone::ResponseVote response;
 
+    set_deadline(context, timeout_ms);
+
     request.set_session_id(secret);
     request.set_candidate_term(term);
     request.set_candidate_id(candidate_id);
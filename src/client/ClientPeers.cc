@@ -0,0 +1,146 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+#include "ClientPeers.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool ClientPeers::start_call(const string& endpoint, time_point& start,
+                             string& error)
+{
+    start = chrono::steady_clock::now();
+
+    lock_guard<mutex> lock(peers_mutex);
+
+    auto it = peers.find(endpoint);
+
+    if ( it == peers.end() || it->second.failures == 0 )
+    {
+        return true;
+    }
+
+    if ( start < it->second.retry )
+    {
+        auto wait = chrono::duration_cast<chrono::milliseconds>(
+                        it->second.retry - start);
+
+        ostringstream oss;
+
+        oss << "Peer " << endpoint << " not reachable after "
+            << it->second.failures << " tries, retrying in "
+            << wait.count() << "ms";
+
+        error = oss.str();
+
+        return false;
+    }
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void ClientPeers::end_call(const string& endpoint, const time_point& start,
+                           bool ok)
+{
+    auto now = chrono::steady_clock::now();
+
+    double rtt = chrono::duration<double, milli>(now - start).count();
+
+    lock_guard<mutex> lock(peers_mutex);
+
+    Peer& peer = peers[endpoint];
+
+    peer.calls++;
+
+    if ( ok )
+    {
+        peer.failures = 0;
+        peer.last_rtt = rtt;
+
+        if ( peer.rtt == 0 )
+        {
+            peer.rtt = rtt;
+        }
+        else
+        {
+            peer.rtt = RTT_ALPHA * rtt + (1 - RTT_ALPHA) * peer.rtt;
+        }
+
+        return;
+    }
+
+    peer.errors++;
+    peer.failures++;
+
+    unsigned int shift = min(peer.failures - 1, 16U);
+
+    unsigned int backoff = min(MIN_BACKOFF << shift, MAX_BACKOFF);
+
+    peer.retry = now + chrono::milliseconds(backoff);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void ClientPeers::reset(const string& endpoint)
+{
+    lock_guard<mutex> lock(peers_mutex);
+
+    peers.erase(endpoint);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+string& ClientPeers::to_xml(string& xml)
+{
+    ostringstream oss;
+
+    oss << fixed << setprecision(3);
+
+    oss << "<PEERS>";
+
+    lock_guard<mutex> lock(peers_mutex);
+
+    for (const auto& it : peers)
+    {
+        const Peer& peer = it.second;
+
+        oss << "<PEER>"
+            << "<ENDPOINT><![CDATA[" << it.first << "]]></ENDPOINT>"
+            << "<CALLS>"    << peer.calls    << "</CALLS>"
+            << "<ERRORS>"   << peer.errors   << "</ERRORS>"
+            << "<FAILURES>" << peer.failures << "</FAILURES>"
+            << "<RTT>"      << peer.rtt      << "</RTT>"
+            << "<LAST_RTT>" << peer.last_rtt << "</LAST_RTT>"
+            << "</PEER>";
+    }
+
+    oss << "</PEERS>";
+
+    xml = oss.str();
+
+    return xml;
+}
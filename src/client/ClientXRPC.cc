@@ -29,6 +29,10 @@
 
 using namespace std;
 
+map<string, unique_ptr<ClientXRPC::PeerTransport>> ClientXRPC::peer_transports;
+
+mutex ClientXRPC::peer_mutex;
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -414,6 +418,72 @@ int ClientXRPC::fed_replicate(const std::string& endpoint,
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+int ClientXRPC::fed_replicate_batch(const std::string& endpoint,
+                                    const std::string& secret,
+                                    uint64_t prev_index,
+                                    const std::vector<uint64_t>& indexes,
+                                    const std::vector<std::string>& sqls,
+                                    time_t timeout_ms,
+                                    bool& success,
+                                    uint64_t& last,
+                                    std::string& error_msg)
+{
+    static const std::string replica_method = "one.zone.fedreplicatebatch";
+
+    // -------------------------------------------------------------------------
+    // Get parameters to call append entries on follower
+    // -------------------------------------------------------------------------
+    xmlrpc_c::value result;
+    xmlrpc_c::paramList replica_params;
+
+    std::vector<xmlrpc_c::value> xindexes;
+    std::vector<xmlrpc_c::value> xsqls;
+
+    for (auto idx : indexes)
+    {
+        xindexes.push_back(xmlrpc_c::value_i8(idx));
+    }
+
+    for (const auto& sql : sqls)
+    {
+        xsqls.push_back(xmlrpc_c::value_string(sql));
+    }
+
+    replica_params.add(xmlrpc_c::value_string(secret));
+    replica_params.add(xmlrpc_c::value_i8(prev_index));
+    replica_params.add(xmlrpc_c::value_array(xindexes));
+    replica_params.add(xmlrpc_c::value_array(xsqls));
+
+    // -------------------------------------------------------------------------
+    // Do the XML-RPC call
+    // -------------------------------------------------------------------------
+    int rc = call(endpoint, replica_method, replica_params,
+                  timeout_ms, &result, error_msg);
+
+    if (rc != 0)
+    {
+        return rc;
+    }
+
+    const auto values = xmlrpc_c::value_array(result).vectorValueValue();
+    success = xmlrpc_c::value_boolean(values[0]);
+
+    if ( success )
+    {
+        last = xmlrpc_c::value_i8(values[1]);
+    }
+    else
+    {
+        error_msg = xmlrpc_c::value_string(values[1]);
+        last  = xmlrpc_c::value_i8(values[4]);
+    }
+
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 int ClientXRPC::replicate(const std::string& endpoint,
                           const std::string& secret,
                           const replicate_params& params,
@@ -637,11 +707,33 @@ int ClientXRPC::call(const string& endpoint,
 // client performs better.
 //    xmlrpc_c::clientXmlTransport_curl transport(
 //        xmlrpc_c::clientXmlTransport_curl::constrOpt().timeout(_timeout));
-    xmlrpc_c::clientXmlTransport_curl transport;
+    PeerTransport * peer = peer_transport(endpoint);
+
+    unique_lock<mutex> peer_lock(peer->mtx, try_to_lock);
+
+    unique_ptr<xmlrpc_c::clientXmlTransport_curl> own_transport;
+
+    xmlrpc_c::clientXmlTransport_curl * transport;
+
+    if ( peer_lock.owns_lock() )
+    {
+        if ( !peer->transport )
+        {
+            peer->transport.reset(new xmlrpc_c::clientXmlTransport_curl());
+        }
+
+        transport = peer->transport.get();
+    }
+    else
+    {
+        own_transport.reset(new xmlrpc_c::clientXmlTransport_curl());
+
+        transport = own_transport.get();
+    }
 
     xmlrpc_c::carriageParm_curl0  carriage(endpoint);
 
-    xmlrpc_c::client_xml client(&transport);
+    xmlrpc_c::client_xml client(transport);
     xmlrpc_c::rpcPtr     rpc_client(method, plist);
 
     int xml_rc   = 0;
@@ -674,6 +766,11 @@ int ClientXRPC::call(const string& endpoint,
 
                 error  = failure.getDescription();
                 xml_rc = -1;
+
+                if ( failure.getCode() == xmlrpc_c::fault::CODE_NO_SUCH_METHOD )
+                {
+                    xml_rc = -2;
+                }
             }
         }
         else //rpc not finished. Interrupt it
@@ -692,5 +789,29 @@ int ClientXRPC::call(const string& endpoint,
         xml_rc = -1;
     }
 
+    // Do not reuse the transport after a failed call, it is released after
+    // the client
+    if ( xml_rc == -1 && peer_lock.owns_lock() )
+    {
+        own_transport = std::move(peer->transport);
+    }
+
     return xml_rc;
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+ClientXRPC::PeerTransport * ClientXRPC::peer_transport(const string& endpoint)
+{
+    lock_guard<mutex> lock(peer_mutex);
+
+    auto& peer = peer_transports[endpoint];
+
+    if ( !peer )
+    {
+        peer.reset(new PeerTransport());
+    }
+
+    return peer.get();
+}
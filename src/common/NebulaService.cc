@@ -59,3 +59,26 @@ NebulaLog::LogType NebulaService::get_log_system(NebulaLog::LogType default_) co
 
     return log_system;
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+size_t NebulaService::get_log_buffer(LogWriter::Overflow& overflow) const
+{
+    size_t buffer_size = 0;
+
+    overflow = LogWriter::BLOCK;
+
+    const VectorAttribute * log = config->get("LOG");
+
+    if (log != 0)
+    {
+        string value = log->vector_value("OVERFLOW");
+
+        log->vector_value("BUFFER_SIZE", buffer_size);
+
+        overflow = LogWriter::str_to_overflow(value);
+    }
+
+    return buffer_size;
+}
@@ -21,11 +21,38 @@
 #include "Nebula.h"
 #include "HookManager.h"
 #include "NebulaUtil.h"
+#include "RaftManager.h"
 
 #include <sstream>
 
 using namespace std;
 
+/**
+ *  Buffered records are written every FLUSH_PERIOD seconds or when the
+ *  buffer reaches FLUSH_RECORDS. Retention is enforced every TRIM_PERIOD
+ */
+static const double FLUSH_PERIOD  = 1;
+static const size_t FLUSH_RECORDS = 100;
+static const time_t TRIM_PERIOD   = 60;
+
+/**
+ *  Number of times a record is written before it is discarded
+ */
+static const int FLUSH_RETRIES = 5;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+/**
+ *  The hook log is written by the leader (or solo) server
+ */
+static bool is_leader()
+{
+    RaftManager * raftm = Nebula::instance().get_raftm();
+
+    return raftm && (raftm->is_leader() || raftm->is_solo());
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -40,11 +67,252 @@ int HookLog::bootstrap(SqlDB * db)
 /* -------------------------------------------------------------------------- */
 
 HookLog::HookLog(SqlDB *_db, const VectorAttribute * hl_conf):
-    db(_db)
+    db(_db), last_trim(time(0))
 {
     hl_conf->vector_value("LOG_RETENTION", log_retention);
+
+    timer_thread.start(FLUSH_PERIOD, [this]() {timer_action();});
 };
 
+/* -------------------------------------------------------------------------- */
+
+HookLog::~HookLog()
+{
+    finalize();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HookLog::finalize()
+{
+    timer_thread.stop();
+
+    flush();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void HookLog::timer_action()
+{
+    if (!is_leader())
+    {
+        return;
+    }
+
+    flush();
+
+    time_t the_time = time(0);
+
+    if ( the_time - last_trim >= TRIM_PERIOD )
+    {
+        lock_guard<mutex> lock(flush_mutex);
+
+        trim();
+
+        last_trim = the_time;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HookLog::reset()
+{
+    lock_guard<mutex> flock(flush_mutex);
+
+    lock_guard<mutex> lock(hl_mutex);
+
+    pending.clear();
+
+    trim_hooks.clear();
+
+    last_exeid.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int HookLog::flush()
+{
+    std::vector<Record> records;
+
+    lock_guard<mutex> flock(flush_mutex);
+
+    // Followers do not write the log, pending records are dropped by reset()
+    if (!is_leader())
+    {
+        return 0;
+    }
+
+    {
+        lock_guard<mutex> lock(hl_mutex);
+
+        records.swap(pending);
+    }
+
+    if ( records.empty() )
+    {
+        return 0;
+    }
+
+    ostringstream oss;
+
+    string sql_cmd_start;
+    string sql_cmd_separator;
+    string sql_cmd_end;
+
+    if (db->supports(SqlDB::SqlFeature::MULTIPLE_VALUE))
+    {
+        oss << "INSERT INTO " << one_db::hook_log_table
+            << " (" << one_db::hook_log_db_names << ") VALUES ";
+
+        sql_cmd_start = oss.str();
+
+        sql_cmd_separator = ",";
+    }
+    else
+    {
+        oss << "BEGIN TRANSACTION; "
+            << "INSERT INTO " << one_db::hook_log_table
+            << " (" << one_db::hook_log_db_names << ") VALUES ";
+
+        sql_cmd_start = oss.str();
+
+        oss.str("");
+
+        oss << "; INSERT INTO " << one_db::hook_log_table
+            << " (" << one_db::hook_log_db_names << ") VALUES ";
+
+        sql_cmd_separator = oss.str();
+
+        sql_cmd_end = "; COMMIT";
+    }
+
+    oss.str("");
+
+    oss << sql_cmd_start;
+
+    for (auto it = records.begin(); it != records.end(); ++it)
+    {
+        if ( it != records.begin() )
+        {
+            oss << sql_cmd_separator;
+        }
+
+        oss << it->values;
+    }
+
+    oss << sql_cmd_end;
+
+    int rc = db->exec_wr(oss);
+
+    if ( rc == 0 )
+    {
+        return 0;
+    }
+
+    // Write the records one by one, so a failed record does not discard the
+    // batch. Failed records are retried on next flush.
+    std::vector<Record> failed;
+
+    int lost = 0;
+
+    for (auto& record : records)
+    {
+        oss.str("");
+
+        oss << "INSERT INTO " << one_db::hook_log_table
+            << " (" << one_db::hook_log_db_names << ") VALUES "
+            << record.values;
+
+        if ( db->exec_wr(oss) == 0 )
+        {
+            continue;
+        }
+
+        if ( ++record.retries < FLUSH_RETRIES )
+        {
+            failed.push_back(std::move(record));
+        }
+        else
+        {
+            lost++;
+
+            // Execution ids of lost records may be reused, read them again
+            lock_guard<mutex> lock(hl_mutex);
+
+            last_exeid.erase(record.hkid);
+        }
+    }
+
+    if ( failed.empty() && lost == 0 )
+    {
+        return 0;
+    }
+
+    oss.str("");
+
+    oss << "Error writing " << failed.size() + lost << " hook execution records, "
+        << failed.size() << " will be retried";
+
+    NebulaLog::log("HKM", Log::ERROR, oss);
+
+    lock_guard<mutex> lock(hl_mutex);
+
+    pending.insert(pending.begin(), std::make_move_iterator(failed.begin()),
+                   std::make_move_iterator(failed.end()));
+
+    return -1;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void HookLog::trim()
+{
+    ostringstream oss;
+
+    std::set<int> hooks;
+
+    std::map<int, int> exeids;
+
+    {
+        lock_guard<mutex> lock(hl_mutex);
+
+        hooks.swap(trim_hooks);
+
+        for (auto hkid : hooks)
+        {
+            auto it = last_exeid.find(hkid);
+
+            if ( it != last_exeid.end() && it->second >= log_retention )
+            {
+                exeids.insert(*it);
+            }
+        }
+    }
+
+    if ( exeids.empty() )
+    {
+        return;
+    }
+
+    oss << "DELETE FROM " << one_db::hook_log_table << " WHERE ";
+
+    for (auto it = exeids.begin(); it != exeids.end(); ++it)
+    {
+        if ( it != exeids.begin() )
+        {
+            oss << " OR ";
+        }
+
+        oss << "(hkid = " << it->first
+            << " AND exeid <= " << it->second - log_retention << ")";
+    }
+
+    db->exec_wr(oss);
+}
+
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -53,6 +321,8 @@ int HookLog::_dump_log(int hkid, int exec_id, std::string &xml_log)
 {
     std::ostringstream cmd;
 
+    flush();
+
     string_cb cb(1);
 
     cmd << "SELECT body FROM "<< one_db::hook_log_table;
@@ -86,6 +356,8 @@ int HookLog::dump_log(const std::string &where_clause, std::string &xml_log)
 {
     std::ostringstream cmd;
 
+    flush();
+
     string_cb cb(1);
 
     cmd << "SELECT body FROM "<< one_db::hook_log_table;
@@ -131,6 +403,15 @@ int HookLog::drop(SqlDB *db, const int hook_id)
 {
     ostringstream oss;
 
+    flush();
+
+    {
+        lock_guard<mutex> lock(hl_mutex);
+
+        last_exeid.erase(hook_id);
+        trim_hooks.erase(hook_id);
+    }
+
     oss << "DELETE FROM " << one_db::hook_log_table
         << " WHERE hkid =" << hook_id;
 
@@ -144,80 +425,103 @@ int HookLog::add(int hkid, int hkrc, const std::string &xml_result)
 {
     std::ostringstream oss;
 
-    multiple_cb<std::vector, int> cb;
-
-    vector<int> query_output;
-
     char * sql_xml;
 
-    std::string xml_body;
+    size_t num_pending;
 
-    cb.set_callback(&query_output);
+    time_t the_time = time(0);
 
-    oss << "SELECT coalesce(MAX(exeid), -1), COUNT(*) FROM " << one_db::hook_log_table << " WHERE hkid = " << hkid;
+    if (!is_leader())
+    {
+        return -1;
+    }
 
-    int rc = db->exec_rd(oss, &cb);
+    bool cached;
 
-    if ( rc != 0 )
     {
-        return rc;
+        lock_guard<mutex> lock(hl_mutex);
+
+        cached = last_exeid.count(hkid) > 0;
     }
 
-    int last_exeid = query_output[0] + 1;
-    int num_records = query_output[1];
+    int max_exeid = -1;
 
-    cb.unset_callback();
+    if ( !cached )
+    {
+        // Records of this hook are not buffered, the DB is up to date
+        single_cb<int> cb;
 
-    oss.str("");
+        cb.set_callback(&max_exeid);
 
-    time_t the_time = time(0);
+        oss << "SELECT coalesce(MAX(exeid), -1) FROM "
+            << one_db::hook_log_table << " WHERE hkid = " << hkid;
 
-    oss << "<HOOK_EXECUTION_RECORD>"
-        << "<HOOK_ID>" << hkid << "</HOOK_ID>"
-        << "<EXECUTION_ID>" << last_exeid << "</EXECUTION_ID>"
-        << "<TIMESTAMP>" << the_time << "</TIMESTAMP>"
-        << xml_result
-        << "</HOOK_EXECUTION_RECORD>";
+        int rc = db->exec_rd(oss, &cb);
 
-    sql_xml = db->escape_str(oss.str());
+        cb.unset_callback();
 
-    if ( sql_xml == 0 )
-    {
-        return -1;
+        if ( rc != 0 )
+        {
+            return rc;
+        }
     }
 
-    if ( ObjectXML::validate_xml(sql_xml) != 0 )
     {
-        db->free_str(sql_xml);
-        return -1;
-    }
+        lock_guard<mutex> lock(hl_mutex);
 
-    oss.str("");
+        // Keep the id cached by a concurrent add, it includes its record
+        auto it = last_exeid.insert(make_pair(hkid, max_exeid)).first;
 
-    oss << "INSERT INTO " << one_db::hook_log_table
-        << " (" << one_db::hook_log_db_names << ") VALUES ("
-        << hkid       << ","
-        << last_exeid << ","
-        << the_time   << ","
-        << hkrc       << ","
-        << "'" << sql_xml << "')";
+        int exeid = it->second + 1;
 
-    rc = db->exec_wr(oss);
+        oss.str("");
+
+        oss << "<HOOK_EXECUTION_RECORD>"
+            << "<HOOK_ID>" << hkid << "</HOOK_ID>"
+            << "<EXECUTION_ID>" << exeid << "</EXECUTION_ID>"
+            << "<TIMESTAMP>" << the_time << "</TIMESTAMP>"
+            << xml_result
+            << "</HOOK_EXECUTION_RECORD>";
+
+        sql_xml = db->escape_str(oss.str());
+
+        if ( sql_xml == 0 )
+        {
+            return -1;
+        }
+
+        if ( ObjectXML::validate_xml(sql_xml) != 0 )
+        {
+            db->free_str(sql_xml);
+            return -1;
+        }
 
-    if (num_records >= log_retention)
-    {
         oss.str("");
 
-        oss << "DELETE FROM " << one_db::hook_log_table
-            << " WHERE hkid = " << hkid
-            << " AND exeid <= " << last_exeid - log_retention;
+        oss << "("
+            << hkid     << ","
+            << exeid    << ","
+            << the_time << ","
+            << hkrc     << ","
+            << "'" << sql_xml << "')";
+
+        db->free_str(sql_xml);
+
+        it->second = exeid;
+
+        pending.push_back({hkid, oss.str(), 0});
 
-        rc = db->exec_wr(oss);
+        trim_hooks.insert(hkid);
+
+        num_pending = pending.size();
     }
 
-    db->free_str(sql_xml);
+    if ( num_pending >= FLUSH_RECORDS )
+    {
+        return flush();
+    }
 
-    return rc;
+    return 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -221,6 +221,25 @@ int Host::update_info(Template &tmpl)
 /* ------------------------------------------------------------------------ */
 /* ------------------------------------------------------------------------ */
 
+string& Host::system_to_xml(string& xml) const
+{
+    string template_xml;
+    string share_xml;
+
+    ostringstream oss;
+
+    oss << "<STATE>" << state << "</STATE>"
+        << host_share.to_xml(share_xml)
+        << obj_template->to_xml(template_xml);
+
+    xml = oss.str();
+
+    return xml;
+}
+
+/* ------------------------------------------------------------------------ */
+/* ------------------------------------------------------------------------ */
+
 void Host::update_zombies(const set<int>& zombies)
 {
     remove_template_attribute("ZOMBIES");
@@ -29,6 +29,7 @@
 #include "GroupPool.h"
 #include "ClusterPool.h"
 #include "InformationManager.h"
+#include "RaftManager.h"
 
 using namespace std;
 
@@ -84,6 +85,7 @@ static bool hostname_is_valid(const string& hostname, string& error_str)
 
 HostPool::HostPool(SqlDB * db, const vector<const SingleAttribute *>& ea) :
     PoolSQL(db, one_db::host_table)
+    , capacity_epoch(time(nullptr))
 {
     HostTemplate::parse_encrypted(ea);
 }
@@ -155,6 +157,8 @@ int HostPool::allocate (
 
             auto *im = Nebula::instance().get_im();
             im->update_host(host_ptr.get());
+
+            set_capacity(host_ptr.get());
         }
     }
 
@@ -184,7 +188,14 @@ int HostPool::update(PoolObjectSQL * objsql)
 
     Nebula::instance().get_im()->update_host(host);
 
-    return host->update(db);
+    int rc = host->update(db);
+
+    if ( rc == 0 )
+    {
+        set_capacity(host);
+    }
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -286,3 +297,244 @@ HostMonitoringTemplate HostPool::get_monitoring(int hid)
 
     return info;
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void HostPool::host_capacity(const Host * host, Capacity& record)
+{
+    const HostShare& hs = host->get_host_share();
+
+    record.oid        = host->get_oid();
+    record.cluster_id = host->get_cluster_id();
+    record.state      = static_cast<int>(host->get_state());
+
+    record.cpu_usage = hs.get_cpu_usage();
+    record.max_cpu   = hs.get_max_cpu();
+    record.total_cpu = hs.get_total_cpu();
+
+    record.mem_usage = hs.get_mem_usage();
+    record.max_mem   = hs.get_max_mem();
+    record.total_mem = hs.get_total_mem();
+
+    record.running_vms = hs.get_running_vms();
+
+    hs.pci_count(record.pci_total, record.pci_free);
+
+    record.numa_nodes = hs.numa_nodes();
+
+    record.version = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HostPool::set_capacity(const Host * host)
+{
+    Capacity record;
+
+    host_capacity(host, record);
+
+    lock_guard<mutex> lock(capacity_mutex);
+
+    write_versions[record.oid] = ++write_version;
+
+    auto it = capacity.find(record.oid);
+
+    if ( it != capacity.end() )
+    {
+        const Capacity& c = it->second;
+
+        if ( c.cluster_id == record.cluster_id && c.state == record.state &&
+             c.cpu_usage == record.cpu_usage && c.max_cpu == record.max_cpu &&
+             c.total_cpu == record.total_cpu && c.mem_usage == record.mem_usage &&
+             c.max_mem == record.max_mem && c.total_mem == record.total_mem &&
+             c.running_vms == record.running_vms &&
+             c.pci_total == record.pci_total && c.pci_free == record.pci_free &&
+             c.numa_nodes == record.numa_nodes )
+        {
+            return;
+        }
+    }
+
+    record.version = ++capacity_version;
+
+    capacity[record.oid] = record;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HostPool::drop_capacity(int oid)
+{
+    lock_guard<mutex> lock(capacity_mutex);
+
+    write_versions.erase(oid);
+
+    Capacity& record = capacity[oid];
+
+    record.oid     = oid;
+    record.state   = -1;
+    record.version = ++capacity_version;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HostPool::load_capacity(vector<Capacity>& records)
+{
+    vector<int> oids;
+
+    list(oids);
+
+    for (auto oid : oids)
+    {
+        if ( auto host = get_ro(oid) )
+        {
+            Capacity record;
+
+            host_capacity(host.get(), record);
+
+            records.push_back(record);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t HostPool::get_capacity(uint64_t& epoch, uint64_t since,
+                                vector<Capacity>& records)
+{
+    RaftManager * raftm = Nebula::instance().get_raftm();
+
+    // Followers do not update hosts, the snapshot is only kept by the leader
+    if ( raftm == nullptr || (!raftm->is_leader() && !raftm->is_solo()) )
+    {
+        epoch = 0;
+        return 0;
+    }
+
+    bool loaded;
+
+    {
+        lock_guard<mutex> lock(capacity_mutex);
+
+        loaded = capacity_loaded;
+    }
+
+    if ( !loaded )
+    {
+        vector<Capacity> db_records;
+
+        load_capacity(db_records);
+
+        lock_guard<mutex> lock(capacity_mutex);
+
+        if ( !capacity_loaded )
+        {
+            for (auto& record : db_records)
+            {
+                // Records written while loading are more recent, keep them
+                auto rc = capacity.emplace(record.oid, record);
+
+                if ( rc.second )
+                {
+                    rc.first->second.version = ++capacity_version;
+                }
+            }
+
+            capacity_loaded = true;
+        }
+    }
+
+    lock_guard<mutex> lock(capacity_mutex);
+
+    // Versions of other epochs are not comparable, send all the records
+    if ( epoch != capacity_epoch )
+    {
+        epoch = capacity_epoch;
+        since = 0;
+    }
+
+    for (const auto& it : capacity)
+    {
+        const Capacity& record = it.second;
+
+        if ( record.version <= since || (since == 0 && record.state == -1) )
+        {
+            continue;
+        }
+
+        records.push_back(record);
+    }
+
+    return capacity_version;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void HostPool::reset_capacity()
+{
+    lock_guard<mutex> lock(capacity_mutex);
+
+    capacity.clear();
+
+    capacity_version = 0;
+    capacity_loaded  = false;
+
+    // Epochs of different servers should not match, use the time if possible
+    capacity_epoch = max(static_cast<uint64_t>(time(nullptr)), capacity_epoch + 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t HostPool::get_write_version(int oid)
+{
+    lock_guard<mutex> lock(capacity_mutex);
+
+    auto it = write_versions.find(oid);
+
+    if ( it == write_versions.end() )
+    {
+        return 0;
+    }
+
+    return it->second;
+}
+
+/* -------------------------------------------------------------------------- */
+
+string& HostPool::capacity_to_xml(uint64_t epoch,
+                                  uint64_t version,
+                                  const vector<Capacity>& records,
+                                  string& xml)
+{
+    ostringstream oss;
+
+    oss << "<HOST_CAPACITY_POOL>"
+        << "<EPOCH>"   << epoch   << "</EPOCH>"
+        << "<VERSION>" << version << "</VERSION>";
+
+    for (const auto& c : records)
+    {
+        oss << "<HOST>"
+            << "<ID>"          << c.oid         << "</ID>"
+            << "<CLUSTER_ID>"  << c.cluster_id  << "</CLUSTER_ID>"
+            << "<STATE>"       << c.state       << "</STATE>"
+            << "<CPU_USAGE>"   << c.cpu_usage   << "</CPU_USAGE>"
+            << "<MAX_CPU>"     << c.max_cpu     << "</MAX_CPU>"
+            << "<TOTAL_CPU>"   << c.total_cpu   << "</TOTAL_CPU>"
+            << "<MEM_USAGE>"   << c.mem_usage   << "</MEM_USAGE>"
+            << "<MAX_MEM>"     << c.max_mem     << "</MAX_MEM>"
+            << "<TOTAL_MEM>"   << c.total_mem   << "</TOTAL_MEM>"
+            << "<RUNNING_VMS>" << c.running_vms << "</RUNNING_VMS>"
+            << "<PCI_TOTAL>"   << c.pci_total   << "</PCI_TOTAL>"
+            << "<PCI_FREE>"    << c.pci_free    << "</PCI_FREE>"
+            << "<NUMA_NODES>"  << c.numa_nodes  << "</NUMA_NODES>"
+            << "<VERSION>"     << c.version     << "</VERSION>"
+            << "</HOST>";
+    }
+
+    oss << "</HOST_CAPACITY_POOL>";
+
+    xml = oss.str();
+
+    return xml;
+}
@@ -227,8 +227,12 @@ void InformationManager::_undefined(unique_ptr<im_msg_t> msg)
 
 void InformationManager::_host_state(unique_ptr<im_msg_t> msg)
 {
-    NebulaLog::ddebug("InM", "HOST_STATE update from host: " +
-                      to_string(msg->oid()) + ". Host information: " + msg->payload());
+    if ( NebulaLog::log_level() >= Log::DDEBUG )
+    {
+        NebulaLog::ddebug("InM", "HOST_STATE update from host: " +
+                          to_string(msg->oid()) + ". Host information: " +
+                          msg->payload());
+    }
 
     string str_state;
     string err_message;
@@ -289,8 +293,12 @@ void InformationManager::_host_state(unique_ptr<im_msg_t> msg)
 
 void InformationManager::_host_system(unique_ptr<im_msg_t> msg)
 {
-    NebulaLog::ddebug("InM", "HOST_SYSTEM update from host: " +
-                      to_string(msg->oid()) + ". Host information: " + msg->payload());
+    if ( NebulaLog::log_level() >= Log::DDEBUG )
+    {
+        NebulaLog::ddebug("InM", "HOST_SYSTEM update from host: " +
+                          to_string(msg->oid()) + ". Host information: " +
+                          msg->payload());
+    }
 
     char *   error_msg;
     Template tmpl;
@@ -324,9 +332,28 @@ void InformationManager::_host_system(unique_ptr<im_msg_t> msg)
     }
 
     // -------------------------------------------------------------------------
+    // Update the host, DB (and monitord) only if system information changed
+    // -------------------------------------------------------------------------
+    string prev_xml;
+    string new_xml;
+
+    host->system_to_xml(prev_xml);
 
     host->update_info(tmpl);
 
+    ++host_updates;
+
+    if ( host->system_to_xml(new_xml) == prev_xml )
+    {
+        ++host_updates_skipped;
+
+        NebulaLog::debug("InM", "Host " + host->get_name() + " (" +
+                         to_string(host->get_oid()) + ") successfully monitored,"
+                         " no changes (" + to_string(host_updates_skipped) +
+                         " of " + to_string(host_updates) + " updates skipped).");
+        return;
+    }
+
     hpool->update(host.get());
 
     NebulaLog::debug("InM", "Host " + host->get_name() + " (" +
@@ -336,22 +363,22 @@ void InformationManager::_host_system(unique_ptr<im_msg_t> msg)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-static void test_and_trigger(const string& state_str, VirtualMachine * vm)
+/**
+ *  Returns the LCM trigger for a state reported by the monitor, or nullptr if
+ *  the reported state does not imply a state transition
+ *    @param state_str reported by the monitor
+ *    @param state of the VM
+ *    @param lcm_state of the VM
+ *    @param info message to log in the VM if any
+ */
+typedef void (LifeCycleManager::*monitor_trigger_t)(int);
+
+static monitor_trigger_t monitor_trigger(const string& state_str,
+                                         VirtualMachine::VmState state,
+                                         VirtualMachine::LcmState lcm_state,
+                                         const char *& info)
 {
-    time_t the_time = time(0);
-
-    // Prevent Monitor and VMM driver race condition.
-    // Ignore state updates for 30s after state changes
-    if ( the_time - vm->get_running_etime() < 30 ||
-         the_time - vm->get_running_stime() < 30 )
-    {
-        vm->log("VMM", Log::INFO, "Ignoring VM state update");
-        return;
-    }
-
-    auto state = vm->get_state();
-    auto lcm_state = vm->get_lcm_state();
-    auto lcm = Nebula::instance().get_lcm();
+    info = nullptr;
 
     if (state_str == "RUNNING")
     {
@@ -371,8 +398,7 @@ static void test_and_trigger(const string& state_str, VirtualMachine * vm)
               lcm_state == VirtualMachine::BOOT_UNDEPLOY_FAILURE ||
               lcm_state == VirtualMachine::BOOT_FAILURE)))
         {
-            lcm->trigger_monitor_poweron(vm->get_oid());
-            return;
+            return &LifeCycleManager::trigger_monitor_poweron;
         }
     }
     else if (state_str == "FAILURE")
@@ -381,12 +407,9 @@ static void test_and_trigger(const string& state_str, VirtualMachine * vm)
             (lcm_state == VirtualMachine::RUNNING ||
              lcm_state == VirtualMachine::UNKNOWN))
         {
-            lcm->trigger_monitor_done(vm->get_oid());
-
-            vm->log("VMM", Log::INFO,
-                    "VM running but monitor state is ERROR.");
+            info = "VM running but monitor state is ERROR.";
 
-            return;
+            return &LifeCycleManager::trigger_monitor_done;
         }
     }
     else if (state_str == "SUSPENDED")
@@ -395,12 +418,9 @@ static void test_and_trigger(const string& state_str, VirtualMachine * vm)
             (lcm_state == VirtualMachine::RUNNING ||
              lcm_state == VirtualMachine::UNKNOWN))
         {
-            lcm->trigger_monitor_suspend(vm->get_oid());
-
-            vm->log("VMM", Log::INFO,
-                    "VM running but monitor state is PAUSED.");
+            info = "VM running but monitor state is PAUSED.";
 
-            return;
+            return &LifeCycleManager::trigger_monitor_suspend;
         }
     }
     else if (state_str == "POWEROFF")
@@ -412,10 +432,82 @@ static void test_and_trigger(const string& state_str, VirtualMachine * vm)
              lcm_state == VirtualMachine::SHUTDOWN_POWEROFF ||
              lcm_state == VirtualMachine::SHUTDOWN_UNDEPLOY))
         {
-            lcm->trigger_monitor_poweroff(vm->get_oid());
-            return;
+            return &LifeCycleManager::trigger_monitor_poweroff;
         }
     }
+
+    return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static void test_and_trigger(const string& state_str, VirtualMachine * vm)
+{
+    time_t the_time = time(0);
+
+    // Prevent Monitor and VMM driver race condition.
+    // Ignore state updates for 30s after state changes
+    if ( the_time - vm->get_running_etime() < 30 ||
+         the_time - vm->get_running_stime() < 30 )
+    {
+        vm->log("VMM", Log::INFO, "Ignoring VM state update");
+        return;
+    }
+
+    const char * info;
+
+    auto trigger = monitor_trigger(state_str, vm->get_state(),
+                                   vm->get_lcm_state(), info);
+
+    if ( trigger == nullptr )
+    {
+        return;
+    }
+
+    auto lcm = Nebula::instance().get_lcm();
+
+    (lcm->*trigger)(vm->get_oid());
+
+    if ( info != nullptr )
+    {
+        vm->log("VMM", Log::INFO, info);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ *  Checks if a state report can be skipped using the VM state table. The
+ *  report is skipped when:
+ *    - the VM is running in the host that sent the report
+ *    - the deploy ID does not need to be updated
+ *    - the reported state does not imply a state transition
+ *    - the VM info of the history record is updated (vm_info_period)
+ */
+static bool skip_state(const VirtualMachinePool::VmStateEntry& vms, int hid,
+                       const string& state_str, const string& deploy_id,
+                       time_t the_time)
+{
+    static const time_t vm_info_period = 600;
+
+    const char * info;
+
+    if ( vms.hid != hid )
+    {
+        return false;
+    }
+
+    if ( state_str == "RUNNING" && vms.deploy_id != deploy_id )
+    {
+        return false;
+    }
+
+    if ( the_time - vms.info >= vm_info_period )
+    {
+        return false;
+    }
+
+    return monitor_trigger(state_str, vms.state, vms.lcm_state, info) == nullptr;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -453,6 +545,10 @@ void InformationManager::_vm_state(unique_ptr<im_msg_t> msg)
 
     set<int> hv_ids;
 
+    time_t the_time = time(nullptr);
+
+    VirtualMachinePool::VmStateEntry vm_state;
+
     for (const auto& vm_tmpl : vms)
     {
         if (vm_tmpl->vector_value("ID", id) != 0)
@@ -469,6 +565,13 @@ void InformationManager::_vm_state(unique_ptr<im_msg_t> msg)
                          to_string(msg->oid()) + ". VM id: " + to_string(id) + ", state: " +
                          state_str);
 
+        // Steady-state reports are filtered with the VM state table
+        if (vmpool->get_vm_state(id, vm_state) &&
+            skip_state(vm_state, msg->oid(), state_str, deploy_id, the_time))
+        {
+            continue;
+        }
+
         auto vm = vmpool->get(id);
 
         if (vm == nullptr)
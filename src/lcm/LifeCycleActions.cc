@@ -1861,186 +1861,253 @@ void LifeCycleManager::retry(VirtualMachine * vm)
 /*  -------------------------------------------------------------------------- */
 /*  -------------------------------------------------------------------------- */
 
-void LifeCycleManager::trigger_updatesg(int sgid)
+/**
+ *  Security group update needed by a VM, depending on its state
+ */
+enum SGUpdate
 {
-    trigger([this, sgid]
+    SG_ERROR    = 0, // Cannot update VM, SG rules being updated/created
+    SG_TEMPLATE = 1, // Update just the VM information
+    SG_UPDATE   = 2  // Update VM information + SG rules at host
+};
+
+static SGUpdate sg_update_type(VirtualMachine * vm)
+{
+    VirtualMachine::LcmState lstate = vm->get_lcm_state();
+
+    if ( vm->get_state() != VirtualMachine::ACTIVE )
     {
-        int  vmid, rc;
+        return SG_TEMPLATE;
+    }
 
-        auto sg = sgpool->get(sgid);
+    switch (lstate)
+    {
+        //Cannnot update VM, SG rules being updated/created
+        case VirtualMachine::BOOT:
+        case VirtualMachine::BOOT_MIGRATE:
+        case VirtualMachine::BOOT_SUSPENDED:
+        case VirtualMachine::BOOT_STOPPED:
+        case VirtualMachine::BOOT_UNDEPLOY:
+        case VirtualMachine::BOOT_POWEROFF:
+        case VirtualMachine::BOOT_UNKNOWN:
+        case VirtualMachine::BOOT_FAILURE:
+        case VirtualMachine::BOOT_MIGRATE_FAILURE:
+        case VirtualMachine::BOOT_UNDEPLOY_FAILURE:
+        case VirtualMachine::BOOT_STOPPED_FAILURE:
+        case VirtualMachine::MIGRATE:
+        case VirtualMachine::HOTPLUG_NIC:
+        case VirtualMachine::HOTPLUG_NIC_POWEROFF:
+        case VirtualMachine::UNKNOWN:
+            return SG_ERROR;
 
-        if ( sg == nullptr )
-        {
-            return;
-        }
+        //Update just VM information
+        case VirtualMachine::LCM_INIT:
+        case VirtualMachine::PROLOG:
+        case VirtualMachine::PROLOG_MIGRATE_FAILURE:
+        case VirtualMachine::PROLOG_MIGRATE_POWEROFF_FAILURE:
+        case VirtualMachine::PROLOG_MIGRATE_SUSPEND_FAILURE:
+        case VirtualMachine::PROLOG_RESUME_FAILURE:
+        case VirtualMachine::PROLOG_UNDEPLOY_FAILURE:
+        case VirtualMachine::PROLOG_MIGRATE_UNKNOWN_FAILURE:
+        case VirtualMachine::PROLOG_FAILURE:
+        case VirtualMachine::PROLOG_MIGRATE:
+        case VirtualMachine::PROLOG_MIGRATE_POWEROFF:
+        case VirtualMachine::PROLOG_MIGRATE_SUSPEND:
+        case VirtualMachine::PROLOG_MIGRATE_UNKNOWN:
+        case VirtualMachine::PROLOG_RESUME:
+        case VirtualMachine::PROLOG_UNDEPLOY:
+        case VirtualMachine::EPILOG:
+        case VirtualMachine::EPILOG_STOP:
+        case VirtualMachine::EPILOG_UNDEPLOY:
+        case VirtualMachine::EPILOG_FAILURE:
+        case VirtualMachine::EPILOG_STOP_FAILURE:
+        case VirtualMachine::EPILOG_UNDEPLOY_FAILURE:
+        case VirtualMachine::SHUTDOWN:
+        case VirtualMachine::SHUTDOWN_POWEROFF:
+        case VirtualMachine::SHUTDOWN_UNDEPLOY:
+        case VirtualMachine::SAVE_STOP:
+        case VirtualMachine::SAVE_SUSPEND:
+        case VirtualMachine::SAVE_MIGRATE:
+        case VirtualMachine::CLEANUP_RESUBMIT:
+        case VirtualMachine::CLEANUP_DELETE:
+        case VirtualMachine::DISK_RESIZE_POWEROFF:
+        case VirtualMachine::DISK_RESIZE_UNDEPLOYED:
+        case VirtualMachine::DISK_SNAPSHOT_POWEROFF:
+        case VirtualMachine::DISK_SNAPSHOT_REVERT_POWEROFF:
+        case VirtualMachine::DISK_SNAPSHOT_DELETE_POWEROFF:
+        case VirtualMachine::DISK_SNAPSHOT_SUSPENDED:
+        case VirtualMachine::DISK_SNAPSHOT_DELETE_SUSPENDED:
+        case VirtualMachine::HOTPLUG_SAVEAS_POWEROFF:
+        case VirtualMachine::HOTPLUG_SAVEAS_SUSPENDED:
+        case VirtualMachine::HOTPLUG_SAVEAS_UNDEPLOYED:
+        case VirtualMachine::HOTPLUG_SAVEAS_STOPPED:
+        case VirtualMachine::HOTPLUG_PROLOG_POWEROFF:
+        case VirtualMachine::HOTPLUG_EPILOG_POWEROFF:
+        case VirtualMachine::BACKUP_POWEROFF:
+        case VirtualMachine::RESTORE:
+            return SG_TEMPLATE;
 
-        // -------------------------------------------------------------------------
-        // Iterate over SG VMs, rules at hypervisor are updated one by one
-        // -------------------------------------------------------------------------
+        //Update VM information + SG rules at host
+        case VirtualMachine::RUNNING:
+        case VirtualMachine::HOTPLUG:
+        case VirtualMachine::HOTPLUG_SNAPSHOT:
+        case VirtualMachine::HOTPLUG_SAVEAS:
+        case VirtualMachine::HOTPLUG_RESIZE:
+        case VirtualMachine::DISK_SNAPSHOT:
+        case VirtualMachine::DISK_SNAPSHOT_DELETE:
+        case VirtualMachine::DISK_RESIZE:
+        case VirtualMachine::BACKUP:
+            return SG_UPDATE;
+    }
+
+    return SG_ERROR;
+}
+
+/*  -------------------------------------------------------------------------- */
+
+void LifeCycleManager::trigger_updatesg(int sgid)
+{
+    trigger([this, sgid]
+    {
+        // ---------------------------------------------------------------------
+        // Iterate over SG VMs in batches. Rules at hypervisor are updated with
+        // a driver action per host, the next batch is processed when all the
+        // VMs have been updated.
+        // ---------------------------------------------------------------------
         do
         {
-            bool is_error  = false;
-            bool is_tmpl   = false;
-            bool is_update = false;
+            vector<int> vms;
+
+            if ( auto sg = sgpool->get(sgid) )
+            {
+                int vmid;
 
-            rc = sg->get_outdated(vmid);
+                if ( sg->get_updating() > 0 )
+                {
+                    return;
+                }
 
-            sgpool->update(sg.get());
+                while ( vms.size() < SG_BATCH_SIZE && sg->get_outdated(vmid) == 0 )
+                {
+                    vms.push_back(vmid);
+                }
 
-            sg.reset();
+                if ( vms.empty() )
+                {
+                    return;
+                }
 
-            if ( rc != 0 )
+                sgpool->update(sg.get());
+            }
+            else
             {
                 return;
             }
 
-            if ( auto vm = vmpool->get(vmid) )
+            // SG rules are fetched once per batch, each VM gets a copy
+            vector<VectorAttribute *> batch_rules;
+
+            sgpool->get_security_group_rules(-1, sgid, batch_rules);
+
+            vector<int> error_vms;
+            vector<int> tmpl_vms;
+            vector<int> update_vms;
+
+            // VM driver data by host (vmm_mad, hostname)
+            map<pair<string, string>, vector<pair<int, string>>> hosts;
+
+            for (int vmid : vms)
             {
-                VirtualMachine::LcmState lstate = vm->get_lcm_state();
-                VirtualMachine::VmState  state  = vm->get_state();
+                auto vm = vmpool->get(vmid);
 
-                if ( state != VirtualMachine::ACTIVE ) //Update just VM info
+                if ( !vm )
                 {
-                    is_tmpl = true;
+                    continue;
                 }
-                else
-                {
-                    switch (lstate)
-                    {
-                        //Cannnot update VM, SG rules being updated/created
-                        case VirtualMachine::BOOT:
-                        case VirtualMachine::BOOT_MIGRATE:
-                        case VirtualMachine::BOOT_SUSPENDED:
-                        case VirtualMachine::BOOT_STOPPED:
-                        case VirtualMachine::BOOT_UNDEPLOY:
-                        case VirtualMachine::BOOT_POWEROFF:
-                        case VirtualMachine::BOOT_UNKNOWN:
-                        case VirtualMachine::BOOT_FAILURE:
-                        case VirtualMachine::BOOT_MIGRATE_FAILURE:
-                        case VirtualMachine::BOOT_UNDEPLOY_FAILURE:
-                        case VirtualMachine::BOOT_STOPPED_FAILURE:
-                        case VirtualMachine::MIGRATE:
-                        case VirtualMachine::HOTPLUG_NIC:
-                        case VirtualMachine::HOTPLUG_NIC_POWEROFF:
-                        case VirtualMachine::UNKNOWN:
-                            is_error = true;
-                            break;
 
-                        //Update just VM information
-                        case VirtualMachine::LCM_INIT:
-                        case VirtualMachine::PROLOG:
-                        case VirtualMachine::PROLOG_MIGRATE_FAILURE:
-                        case VirtualMachine::PROLOG_MIGRATE_POWEROFF_FAILURE:
-                        case VirtualMachine::PROLOG_MIGRATE_SUSPEND_FAILURE:
-                        case VirtualMachine::PROLOG_RESUME_FAILURE:
-                        case VirtualMachine::PROLOG_UNDEPLOY_FAILURE:
-                        case VirtualMachine::PROLOG_MIGRATE_UNKNOWN_FAILURE:
-                        case VirtualMachine::PROLOG_FAILURE:
-                        case VirtualMachine::PROLOG_MIGRATE:
-                        case VirtualMachine::PROLOG_MIGRATE_POWEROFF:
-                        case VirtualMachine::PROLOG_MIGRATE_SUSPEND:
-                        case VirtualMachine::PROLOG_MIGRATE_UNKNOWN:
-                        case VirtualMachine::PROLOG_RESUME:
-                        case VirtualMachine::PROLOG_UNDEPLOY:
-                        case VirtualMachine::EPILOG:
-                        case VirtualMachine::EPILOG_STOP:
-                        case VirtualMachine::EPILOG_UNDEPLOY:
-                        case VirtualMachine::EPILOG_FAILURE:
-                        case VirtualMachine::EPILOG_STOP_FAILURE:
-                        case VirtualMachine::EPILOG_UNDEPLOY_FAILURE:
-                        case VirtualMachine::SHUTDOWN:
-                        case VirtualMachine::SHUTDOWN_POWEROFF:
-                        case VirtualMachine::SHUTDOWN_UNDEPLOY:
-                        case VirtualMachine::SAVE_STOP:
-                        case VirtualMachine::SAVE_SUSPEND:
-                        case VirtualMachine::SAVE_MIGRATE:
-                        case VirtualMachine::CLEANUP_RESUBMIT:
-                        case VirtualMachine::CLEANUP_DELETE:
-                        case VirtualMachine::DISK_RESIZE_POWEROFF:
-                        case VirtualMachine::DISK_RESIZE_UNDEPLOYED:
-                        case VirtualMachine::DISK_SNAPSHOT_POWEROFF:
-                        case VirtualMachine::DISK_SNAPSHOT_REVERT_POWEROFF:
-                        case VirtualMachine::DISK_SNAPSHOT_DELETE_POWEROFF:
-                        case VirtualMachine::DISK_SNAPSHOT_SUSPENDED:
-                        case VirtualMachine::DISK_SNAPSHOT_DELETE_SUSPENDED:
-                        case VirtualMachine::HOTPLUG_SAVEAS_POWEROFF:
-                        case VirtualMachine::HOTPLUG_SAVEAS_SUSPENDED:
-                        case VirtualMachine::HOTPLUG_SAVEAS_UNDEPLOYED:
-                        case VirtualMachine::HOTPLUG_SAVEAS_STOPPED:
-                        case VirtualMachine::HOTPLUG_PROLOG_POWEROFF:
-                        case VirtualMachine::HOTPLUG_EPILOG_POWEROFF:
-                        case VirtualMachine::BACKUP_POWEROFF:
-                        case VirtualMachine::RESTORE:
-                            is_tmpl = true;
-                            break;
+                SGUpdate type = sg_update_type(vm.get());
 
-                        //Update VM information + SG rules at host
-                        case VirtualMachine::RUNNING:
-                        case VirtualMachine::HOTPLUG:
-                        case VirtualMachine::HOTPLUG_SNAPSHOT:
-                        case VirtualMachine::HOTPLUG_SAVEAS:
-                        case VirtualMachine::HOTPLUG_RESIZE:
-                        case VirtualMachine::DISK_SNAPSHOT:
-                        case VirtualMachine::DISK_SNAPSHOT_DELETE:
-                        case VirtualMachine::DISK_RESIZE:
-                        case VirtualMachine::BACKUP:
-                            is_update = true;
-                            break;
-                    }
+                if ( type == SG_ERROR )
+                {
+                    error_vms.push_back(vmid);
+                    continue;
                 }
 
                 // -------------------------------------------------------------
                 // Update VM template with the new SG rules & trigger update
                 // -------------------------------------------------------------
-                if ( is_tmpl || is_update )
+                vector<VectorAttribute *> sg_rules;
+
+                for (auto rule : batch_rules)
                 {
-                    vector<VectorAttribute *> sg_rules;
+                    sg_rules.push_back(rule->clone());
+                }
 
-                    sgpool->get_security_group_rules(-1, sgid, sg_rules);
+                vm->remove_security_group(sgid);
 
-                    vm->remove_security_group(sgid);
+                vm->add_template_attribute(sg_rules);
 
-                    vm->add_template_attribute(sg_rules);
+                vmpool->update(vm.get());
 
-                    vmpool->update(vm.get());
+                if ( type == SG_TEMPLATE )
+                {
+                    tmpl_vms.push_back(vmid);
+                    continue;
                 }
 
-                if ( is_update )
+                string drv_msg;
+
+                if ( vmm->updatesg_data(vm.get(), sgid, drv_msg) != 0 )
                 {
-                    vmm->updatesg(vm.get(), sgid);
+                    error_vms.push_back(vmid);
+                    continue;
                 }
-            }
-            else
-            {
-                continue;
-            }
 
-            sg = sgpool->get(sgid);
+                auto key = make_pair(vm->get_vmm_mad(), vm->get_hostname());
 
-            if ( sg == nullptr )
-            {
-                return;
+                hosts[key].emplace_back(vmid, std::move(drv_msg));
+
+                update_vms.push_back(vmid);
             }
 
-            // ---------------------------------------------------------------------
-            // Update VM status in the security group and exit
-            // ---------------------------------------------------------------------
-            if ( is_error )
+            for (auto rule : batch_rules)
             {
-                sg->add_error(vmid);
+                delete rule;
             }
-            else if ( is_tmpl )
+
+            // -----------------------------------------------------------------
+            // Update VM status in the security group, once per batch
+            // -----------------------------------------------------------------
+            if ( auto sg = sgpool->get(sgid) )
             {
-                sg->add_vm(vmid);
+                for (int vmid : error_vms)
+                {
+                    sg->add_error(vmid);
+                }
+
+                for (int vmid : tmpl_vms)
+                {
+                    sg->add_vm(vmid);
+                }
+
+                for (int vmid : update_vms)
+                {
+                    sg->add_updating(vmid);
+                }
+
+                sgpool->update(sg.get());
             }
-            else if ( is_update )
+            else
             {
-                sg->add_updating(vmid);
+                return;
             }
 
-            sgpool->update(sg.get());
+            for (const auto& host : hosts)
+            {
+                vmm->updatesg(host.first.first, sgid, host.second);
+            }
 
-            if (is_update)
+            if ( !update_vms.empty() )
             {
                 return;
             }
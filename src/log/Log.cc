@@ -15,8 +15,10 @@
 /* -------------------------------------------------------------------------- */
 
 #include "Log.h"
+#include "LogWriter.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
@@ -33,17 +35,53 @@ const string Log::error_names[] = { "E", "W", "I", "D", "DD", "DDD" };
 
 unsigned int Log::zone_id = 0;
 
+atomic<LogWriter *> FileLog::writer{nullptr};
+
+atomic<int> FileLog::producers{0};
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Log::format_line(
+        string&                 line,
+        const char *            module,
+        const MessageType       type,
+        const char *            message)
+{
+    char   str[26];
+    time_t the_time = time(NULL);
+
+#ifdef SOLARIS
+    ctime_r(&(the_time), str, sizeof(char)*26);
+#else
+    ctime_r(&(the_time), str);
+#endif
+    // Get rid of final enter character
+    str[24] = '\0';
+
+    string zone = to_string(zone_id);
+
+    line.reserve(48 + strlen(module) + strlen(message));
+
+    line.append(str, 24);
+    line.append(" [Z").append(zone).append("][");
+    line.append(module).append("][");
+    line.append(error_names[type]).append("]: ");
+    line.append(message);
+    line.push_back('\n');
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 FileLog::FileLog(const string&   file_name,
                  const MessageType   level,
                  ios_base::openmode  mode)
-    :Log(level), log_file_name(file_name)
+    :Log(level), log_file_name(make_shared<const string>(file_name))
 {
     ofstream file;
 
-    file.open(log_file_name.c_str(), mode);
+    file.open(file_name.c_str(), mode);
 
     if (file.fail() == true)
     {
@@ -64,45 +102,68 @@ FileLog::~FileLog() { }
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+void FileLog::set_writer(LogWriter * _writer)
+{
+    writer.store(_writer);
+
+    // Threads that loaded the previous writer either see the new one when
+    // checking it, or are counted in producers
+    while ( producers.load() > 0 )
+    {
+        this_thread::yield();
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 void FileLog::log(
         const char *            module,
         const MessageType       type,
         const char *            message)
 {
-    char        str[26];
-    time_t      the_time;
-    ofstream    file;
+    if ( type > log_level )
+    {
+        return;
+    }
 
-    if( type <= log_level)
+    string line;
+
+    format_line(line, module, type, message);
+
+    LogWriter * w = writer.load();
+
+    if ( w != nullptr )
     {
-        file.open(log_file_name.c_str(), ios_base::app);
+        producers++;
 
-        if (file.fail() == true)
+        // Check the writer has not been replaced before using it, see
+        // set_writer
+        if ( writer.load() == w )
         {
+            w->write(log_file_name, std::move(line), type == ERROR);
+
+            producers--;
             return;
         }
 
-        the_time = time(NULL);
-
-#ifdef SOLARIS
-        ctime_r(&(the_time), str, sizeof(char)*26);
-#else
-        ctime_r(&(the_time), str);
-#endif
-        // Get rid of final enter character
-        str[24] = '\0';
+        producers--;
+    }
 
-        file << str << " ";
-        file << "[Z"<< zone_id<< "]";
-        file << "[" << module << "]";
-        file << "[" << error_names[type] << "]: ";
-        file << message;
-        file << endl;
+    ofstream file;
 
-        file.flush();
+    file.open(log_file_name->c_str(), ios_base::app);
 
-        file.close();
+    if (file.fail() == true)
+    {
+        return;
     }
+
+    file << line;
+
+    file.flush();
+
+    file.close();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,363 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+
+#include "LogWriter.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <strings.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace std;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+LogWriter::LogWriter(const string& _main_file, size_t size, Overflow _overflow)
+    : main_file(_main_file)
+    , overflow(_overflow)
+{
+    size_t rsize = 2;
+
+    while ( rsize < size )
+    {
+        rsize <<= 1;
+    }
+
+    ring = make_unique<Cell[]>(rsize);
+    mask = rsize - 1;
+
+    for (size_t i = 0; i < rsize; ++i)
+    {
+        ring[i].seq.store(i, memory_order_relaxed);
+    }
+
+    writer_thread = thread(&LogWriter::do_write, this);
+}
+
+/* -------------------------------------------------------------------------- */
+
+LogWriter::~LogWriter()
+{
+    finalize();
+}
+
+/* -------------------------------------------------------------------------- */
+
+LogWriter::Overflow LogWriter::str_to_overflow(const string& str)
+{
+    if ( strcasecmp(str.c_str(), "DROP") == 0 )
+    {
+        return DROP;
+    }
+
+    return BLOCK;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void LogWriter::write(const shared_ptr<const string>& file, string&& line,
+                      bool urgent)
+{
+    if ( end )
+    {
+        write_file(*file, { &line });
+        return;
+    }
+
+    Entry e{file, std::move(line)};
+
+    if ( !push(e) )
+    {
+        if ( overflow == DROP )
+        {
+            dropped++;
+            return;
+        }
+
+        blocked++;
+
+        do
+        {
+            {
+                lock_guard<mutex> lock(writer_mutex);
+            }
+
+            cond.notify_one();
+
+            this_thread::sleep_for(chrono::microseconds(100));
+
+            if ( end )
+            {
+                write_file(*e.file, { &e.line });
+                break;
+            }
+        } while ( !push(e) );
+
+        blocked--;
+    }
+
+    if ( urgent )
+    {
+        cond.notify_one();
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LogWriter::finalize()
+{
+    {
+        lock_guard<mutex> lock(writer_mutex);
+
+        if ( end )
+        {
+            return;
+        }
+
+        end = true;
+    }
+
+    cond.notify_one();
+
+    if ( writer_thread.joinable() )
+    {
+        writer_thread.join();
+    }
+
+    // Lines queued while the writer thread was exiting
+    vector<Entry> batch;
+    Entry         e;
+
+    while ( pop(e) )
+    {
+        batch.push_back(std::move(e));
+    }
+
+    write_batch(batch);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool LogWriter::push(Entry& e)
+{
+    Cell * cell;
+    size_t pos = enqueue_pos.load(memory_order_relaxed);
+
+    while (true)
+    {
+        cell = &ring[pos & mask];
+
+        size_t seq = cell->seq.load(memory_order_acquire);
+
+        intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if ( dif == 0 )
+        {
+            if ( enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                   memory_order_relaxed) )
+            {
+                break;
+            }
+        }
+        else if ( dif < 0 ) // ring is full
+        {
+            return false;
+        }
+        else
+        {
+            pos = enqueue_pos.load(memory_order_relaxed);
+        }
+    }
+
+    cell->entry = std::move(e);
+
+    cell->seq.store(pos + 1, memory_order_release);
+
+    // Wake up the writer every batch of lines
+    if ( ((pos + 1) & (MAX_BATCH - 1)) == 0 )
+    {
+        cond.notify_one();
+    }
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool LogWriter::pop(Entry& e)
+{
+    Cell * cell = &ring[dequeue_pos & mask];
+
+    size_t seq = cell->seq.load(memory_order_acquire);
+
+    if ( static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos + 1) < 0 )
+    {
+        return false;
+    }
+
+    e = std::move(cell->entry);
+
+    cell->seq.store(dequeue_pos + mask + 1, memory_order_release);
+
+    ++dequeue_pos;
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void LogWriter::do_write()
+{
+    vector<Entry> batch;
+
+    batch.reserve(MAX_BATCH);
+
+    while (true)
+    {
+        Entry e;
+
+        while ( batch.size() < MAX_BATCH && pop(e) )
+        {
+            batch.push_back(std::move(e));
+        }
+
+        bool full = batch.size() == MAX_BATCH;
+
+        write_batch(batch);
+
+        if ( full )
+        {
+            continue;
+        }
+
+        if ( end )
+        {
+            break;
+        }
+
+        unique_lock<mutex> lock(writer_mutex);
+
+        cond.wait_for(lock, FLUSH_PERIOD, [&]
+        {
+            return end || blocked > 0;
+        });
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LogWriter::write_batch(vector<Entry>& batch)
+{
+    string drop_line;
+
+    uint64_t ndrop = dropped.exchange(0);
+
+    if ( ndrop > 0 )
+    {
+        string msg = "Log buffer full, " + to_string(ndrop) + " lines dropped";
+
+        Log::format_line(drop_line, "LOG", Log::WARNING, msg.c_str());
+    }
+
+    if ( batch.empty() && drop_line.empty() )
+    {
+        return;
+    }
+
+    unordered_map<string, vector<const string *>> files;
+
+    for (const auto& e : batch)
+    {
+        files[*e.file].push_back(&e.line);
+    }
+
+    if ( !drop_line.empty() )
+    {
+        files[main_file].push_back(&drop_line);
+    }
+
+    for (const auto& file : files)
+    {
+        write_file(file.first, file.second);
+    }
+
+    batch.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LogWriter::write_file(const string& file, const vector<const string *>& lines)
+{
+    int fd = open(file.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+
+    if ( fd == -1 )
+    {
+        return;
+    }
+
+    vector<struct iovec> iov;
+
+    iov.reserve(lines.size());
+
+    for (auto line : lines)
+    {
+        iov.push_back({const_cast<char *>(line->data()), line->size()});
+    }
+
+    size_t i = 0;
+
+    while ( i < iov.size() )
+    {
+        int cnt = static_cast<int>(min(iov.size() - i, static_cast<size_t>(IOV_MAX)));
+
+        ssize_t rc = writev(fd, &iov[i], cnt);
+
+        if ( rc == -1 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        // Skip the written lines, and advance a partially written one
+        while ( i < iov.size() && rc >= static_cast<ssize_t>(iov[i].iov_len) )
+        {
+            rc -= iov[i].iov_len;
+            ++i;
+        }
+
+        if ( rc > 0 )
+        {
+            iov[i].iov_base = static_cast<char *>(iov[i].iov_base) + rc;
+            iov[i].iov_len -= rc;
+        }
+    }
+
+    close(fd);
+}
@@ -22,6 +22,7 @@
 
 Log * NebulaLog::logger;
 NebulaLog::LogType NebulaLog::_log_type;
+LogWriter * NebulaLog::writer = nullptr;
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
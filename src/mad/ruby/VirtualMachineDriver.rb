@@ -224,9 +224,23 @@ class VirtualMachineDriver < OpenNebulaDriver
         send_message(ACTION[:resize_disk],RESULT[:failure],id,error)
     end
 
+    # The reply must start with the security group ID. For a batch
+    # (VMM_DRIVER_ACTION_BATCH) there is a reply for each VM
     def update_sg(id, drv_message)
-        error = "Action not implemented by driver #{self.class}"
-        send_message(ACTION[:update_sg],RESULT[:failure],id,error)
+        error    = "Action not implemented by driver #{self.class}"
+        xml_data = decode(drv_message)
+        sg_id    = xml_data.elements['SECURITY_GROUP_ID'].text
+
+        ids = [id]
+
+        if xml_data.name == 'VMM_DRIVER_ACTION_BATCH'
+            ids = xml_data.elements.collect('VM') {|vm| vm.elements['ID'].text }
+        end
+
+        ids.each do |vm_id|
+            send_message(ACTION[:update_sg],RESULT[:failure],vm_id,
+                         "#{sg_id} #{error}")
+        end
     end
 
     def cleanup(id, drv_message)
@@ -53,6 +53,7 @@
 #include "FedReplicaManager.h"
 #include "HookManager.h"
 #include "HookLog.h"
+#include "QuotaLedger.h"
 #include "ImageManager.h"
 #include "InformationManager.h"
 #include "IPAMManager.h"
@@ -104,6 +105,11 @@ Nebula::~Nebula()
     if (rm_grpc) rm_grpc->finalize();
 #endif
 
+    // Hook log records and VM search updates are written through the Raft log
+    if (hl) hl->finalize();
+
+    if (vmpool) vmpool->finalize_search();
+
     if (raftm) raftm->finalize();
 
     if (!cache)
@@ -188,6 +194,7 @@ Nebula::~Nebula()
     delete rm_xrpc;
     delete hm;
     delete hl;
+    delete qledger;
     delete authm;
     delete aclm;
     delete imagem;
@@ -206,6 +213,8 @@ Nebula::~Nebula()
     delete bjpool;
     delete sapool;
     delete plpool;
+
+    NebulaLog::flush_log_system();
 };
 
 /* -------------------------------------------------------------------------- */
@@ -293,11 +302,14 @@ void Nebula::start(bool bootstrap_only)
 
     try
     {
-        Log::MessageType   clevel;
-        NebulaLog::LogType log_system;
+        Log::MessageType    clevel;
+        NebulaLog::LogType  log_system;
+        LogWriter::Overflow log_overflow;
+        size_t              log_buffer;
 
         log_system = get_log_system();
         clevel     = get_debug_level();
+        log_buffer = get_log_buffer(log_overflow);
 
         // Initializing ONE Daemon log system
         if ( log_system != NebulaLog::UNDEFINED )
@@ -309,7 +321,9 @@ void Nebula::start(bool bootstrap_only)
                                        clevel,
                                        log_fname.c_str(),
                                        ios_base::app,
-                                       "oned");
+                                       "oned",
+                                       log_buffer,
+                                       log_overflow);
         }
         else
         {
@@ -557,7 +571,8 @@ void Nebula::start(bool bootstrap_only)
             }
         }
 
-        logdb = new LogDB(db_backend, solo, cache, log_retention, limit_purge);
+        logdb = new LogDB(db_backend, solo, cache, log_retention, limit_purge,
+                          var_location + "logdb.snapshot");
 
         if ( federation_master )
         {
@@ -937,6 +952,12 @@ void Nebula::start(bool bootstrap_only)
         Client::initialize("", get_master_oned_xmlrpc(), get_master_oned_grpc(),  msg_size, timeout);
     }
 
+    // ---- Quota Ledger ----
+    if (!cache)
+    {
+        qledger = new QuotaLedger();
+    }
+
     // ---- Hook Manager and log----
     if (!cache)
     {
@@ -979,6 +1000,17 @@ void Nebula::start(bool bootstrap_only)
         throw;
     }
 
+    // ---- Quota Ledger and VM search, HA servers start them as leaders ----
+    if (raftm->is_solo())
+    {
+        if (qledger)
+        {
+            qledger->start();
+        }
+
+        vmpool->rebuild_search();
+    }
+
     // ---- FedReplica Manager ----
     if (!cache)
     {
@@ -1206,11 +1238,20 @@ void Nebula::start(bool bootstrap_only)
     {
         int max_backups;
         int max_backups_host;
+        int max_backups_ds;
+        long long max_backups_ds_size;
+        long long backup_ds_rate;
+
         nebula_configuration->get("MAX_BACKUPS", max_backups);
         nebula_configuration->get("MAX_BACKUPS_HOST", max_backups_host);
+        nebula_configuration->get("MAX_BACKUPS_DS", max_backups_ds);
+        nebula_configuration->get("MAX_BACKUPS_DS_SIZE", max_backups_ds_size);
+        nebula_configuration->get("BACKUP_DS_RATE", backup_ds_rate);
 
         // todo Read settings from Scheduler config file
-        sam = new ScheduledActionManager(timer_period, max_backups, max_backups_host);
+        sam = new ScheduledActionManager(timer_period, max_backups,
+                                         max_backups_host, max_backups_ds,
+                                         max_backups_ds_size, backup_ds_rate);
     }
 
     // ---- Scheduler Manager ----
@@ -105,6 +105,16 @@ module GRPCMappings
                 :seconds => args[0]
             )
             stub.pool_monitoring(req, options)
+        end,
+
+        'hostpool.capacity' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::Host::HostService::Stub.new(endpoint, :this_channel_is_insecure)
+            req  = One::Host::PoolCapacityRequest.new(
+                :session_id => one_auth,
+                :version    => args[0],
+                :epoch      => args[1]
+            )
+            stub.pool_capacity(req, options)
         end
     }.freeze
 
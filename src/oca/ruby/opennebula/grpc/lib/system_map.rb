@@ -31,6 +31,13 @@ module GRPCMappings
             stub.config(req, options)
         end,
 
+        'system.metrics' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::System::SystemService::Stub.new(endpoint, :this_channel_is_insecure)
+            req  = One::System::MetricsRequest.new(:session_id => one_auth,
+                                                   :format     => args[0])
+            stub.metrics(req, options)
+        end,
+
         'system.sql' => lambda do |one_auth, endpoint, *args, options|
             stub = One::System::SystemService::Stub.new(endpoint, :this_channel_is_insecure)
             req  = One::System::SqlRequest.new(:session_id => one_auth,
@@ -80,6 +80,18 @@ module GRPCMappings
             stub.instantiate(req, options)
         end,
 
+        'template.instantiatebatch' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::Tmpl::TemplateService::Stub.new(endpoint, :this_channel_is_insecure)
+            req  = One::Tmpl::InstantiateBatchRequest.new(:session_id     => one_auth,
+                                                          :oid            => args[0],
+                                                          :n_vms          => args[1],
+                                                          :name           => args[2],
+                                                          :hold           => args[3],
+                                                          :extra_template => args[4],
+                                                          :persistent     => args[5])
+            stub.instantiate_batch(req, options)
+        end,
+
         'template.chmod' => lambda do |one_auth, endpoint, *args, options|
             stub = One::Tmpl::TemplateService::Stub.new(endpoint, :this_channel_is_insecure)
             req  = One::Tmpl::ChmodRequest.new(:session_id   => one_auth,
@@ -440,6 +440,14 @@ module GRPCMappings
             stub.pool_info_set(req, options)
         end,
 
+        'vmpool.action' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::Vm::VirtualMachineService::Stub.new(endpoint, :this_channel_is_insecure)
+            req = One::Vm::PoolActionRequest.new(:session_id  => one_auth,
+                                                 :action_name => args[0],
+                                                 :ids         => args[1])
+            stub.pool_action(req, options)
+        end,
+
         'vmpool.monitoring' => lambda do |one_auth, endpoint, *args, options|
             stub = One::Vm::VirtualMachineService::Stub.new(endpoint, :this_channel_is_insecure)
             req = One::Vm::PoolMonitoringRequestRequest.new(:session_id  => one_auth,
@@ -457,6 +465,16 @@ module GRPCMappings
             stub.pool_accounting(req, options)
         end,
 
+        'vmpool.accountingtotals' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::Vm::VirtualMachineService::Stub.new(endpoint, :this_channel_is_insecure)
+            req = One::Vm::PoolAccountingTotalsRequest.new(:session_id  => one_auth,
+                                                           :filter_flag => args[0],
+                                                           :group_by    => args[1],
+                                                           :start_time  => args[2],
+                                                           :end_time    => args[3])
+            stub.pool_accounting_totals(req, options)
+        end,
+
         'vmpool.showback' => lambda do |one_auth, endpoint, *args, options|
             stub = One::Vm::VirtualMachineService::Stub.new(endpoint, :this_channel_is_insecure)
             req = One::Vm::PoolShowbackRequest.new(:session_id  => one_auth,
@@ -119,6 +119,15 @@ module GRPCMappings
             stub.replicate_fed_log(req, options)
         end,
 
+        'zone.fedreplicatebatch' => lambda do |one_auth, endpoint, *args, options|
+            stub = One::Zone::ZoneService::Stub.new(endpoint, :this_channel_is_insecure)
+            req  = One::Zone::ReplicateFedLogBatchRequest.new(:session_id => one_auth,
+                                                              :prev       => args[0],
+                                                              :index      => args[1],
+                                                              :sql        => args[2])
+            stub.replicate_fed_log_batch(req, options)
+        end,
+
         'zone.updatedb' => lambda do |one_auth, endpoint, *args, options|
             stub = One::Zone::ZoneService::Stub.new(endpoint, :this_channel_is_insecure)
             req  = One::Zone::UpdateDBRequest.new(:session_id => one_auth,
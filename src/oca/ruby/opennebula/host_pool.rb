@@ -26,7 +26,8 @@ module OpenNebula
 
         HOST_POOL_METHODS = {
             :info       => "hostpool.info",
-            :monitoring => "hostpool.monitoring"
+            :monitoring => "hostpool.monitoring",
+            :capacity   => "hostpool.capacity"
         }
 
         #######################################################################
@@ -111,6 +112,19 @@ module OpenNebula
             @client.call(HOST_POOL_METHODS[:monitoring], num.to_i)
         end
 
+        # Retrieves the capacity records of the Hosts in the pool, in XML
+        #
+        # @param [Integer] version Optional only return the records changed
+        #   after this snapshot version. 0 or nil all records
+        # @param [Integer] epoch Optional EPOCH of the last response. All
+        #   the records are returned if the snapshot epoch has changed
+        #   (e.g. after a leader change)
+        #
+        # @return [String] Host capacity records, in XML
+        def capacity_xml(version = nil, epoch = nil)
+            @client.call(HOST_POOL_METHODS[:capacity], version.to_i, epoch.to_i)
+        end
+
     end
 
 end
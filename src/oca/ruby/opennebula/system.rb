@@ -30,6 +30,7 @@ module OpenNebula
             :groupquotaupdate   => "groupquota.update",
             :version            => "system.version",
             :config             => "system.config",
+            :metrics            => "system.metrics",
             :sql                => "system.sql",
             :sqlquery           => "system.sqlquery"
         }
@@ -115,6 +116,25 @@ module OpenNebula
             return config
         end
 
+        # Gets the internal metrics of the oned server (RPC, DB, Raft and
+        # manager queue statistics)
+        #
+        # @param prometheus [true, false] true to get the metrics in the
+        #   Prometheus text format
+        #
+        # @return [XMLElement, String, OpenNebula::Error] the metrics in case
+        #   of success, Error otherwise
+        def get_metrics(prometheus = false)
+            rc = @client.call(SYSTEM_METHODS[:metrics], prometheus ? 1 : 0)
+
+            return rc if OpenNebula.is_error?(rc) || prometheus
+
+            metrics = XMLElement.new
+            metrics.initialize_xml(rc, 'METRICS')
+
+            return metrics
+        end
+
         # Gets the default user quota limits
         #
         # @return [XMLElement, OpenNebula::Error] the default user quota in case
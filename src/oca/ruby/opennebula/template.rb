@@ -24,17 +24,18 @@ module OpenNebula
         #######################################################################
 
         TEMPLATE_METHODS = {
-            :allocate    => "template.allocate",
-            :instantiate => "template.instantiate",
-            :info        => "template.info",
-            :update      => "template.update",
-            :delete      => "template.delete",
-            :chown       => "template.chown",
-            :chmod       => "template.chmod",
-            :clone       => "template.clone",
-            :rename      => "template.rename",
-            :lock        => "template.lock",
-            :unlock      => "template.unlock"
+            :allocate          => "template.allocate",
+            :instantiate       => "template.instantiate",
+            :instantiate_batch => "template.instantiatebatch",
+            :info              => "template.info",
+            :update            => "template.update",
+            :delete            => "template.delete",
+            :chown             => "template.chown",
+            :chmod             => "template.chmod",
+            :clone             => "template.clone",
+            :rename            => "template.rename",
+            :lock              => "template.lock",
+            :unlock            => "template.unlock"
         }
 
         # Creates a Template description with just its identifier
@@ -137,6 +138,40 @@ module OpenNebula
             return rc
         end
 
+        # Creates a set of VM instances from a Template. The Template is
+        # processed once for all the VMs, if any of them fails the VMs
+        # already created are deleted
+        #
+        # @param n_vms [Integer] Number of VMs to create
+        # @param name [String] Name for the VM instances, "%i" is replaced by
+        #   the index of each VM. If it is an empty string OpenNebula will set
+        #   a default name
+        # @param hold [true,false] false to create the VMs in pending state,
+        #   true to create them on hold
+        # @param template [String] User provided Template to merge with the
+        #   one being instantiated
+        # @param persistent [true,false] true to create a private persistent
+        #   copy of the template plus any image defined in DISK, and instantiate
+        #   that copy. Only allowed when n_vms is 1
+        #
+        # @return [Array<Integer>, OpenNebula::Error] The new VM ids, Error
+        #   otherwise
+        def instantiate_batch(n_vms, name="", hold=false, template="", persistent=false)
+            return Error.new('ID not defined') if !@pe_id
+
+            name ||= ""
+            hold = false if hold.nil?
+            template ||= ""
+            persistent = false if persistent.nil?
+
+            rc = @client.call(TEMPLATE_METHODS[:instantiate_batch], @pe_id,
+                n_vms, name, hold, template, persistent)
+
+            return rc if OpenNebula.is_error?(rc)
+
+            rc.split(',').map {|id| id.to_i }
+        end
+
         # Replaces the template contents
         #
         # @param new_template [String] New template contents
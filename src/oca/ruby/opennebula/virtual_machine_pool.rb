@@ -27,8 +27,10 @@ module OpenNebula
             :info               => 'vmpool.info',
             :info_extended      => 'vmpool.infoextended',
             :info_set           => 'vmpool.infoset',
+            :action             => 'vmpool.action',
             :monitoring         => 'vmpool.monitoring',
             :accounting         => 'vmpool.accounting',
+            :accounting_totals  => 'vmpool.accountingtotals',
             :showback           => 'vmpool.showback',
             :calculate_showback => 'vmpool.calculateshowback'
         }
@@ -37,6 +39,14 @@ module OpenNebula
         INFO_NOT_DONE = -1
         INFO_ALL_VM   = -2
 
+        # Aggregation criteria for accounting totals (include/VirtualMachinePool.h)
+        ACCT_GROUP_BY = {
+            :user    => 0,
+            :group   => 1,
+            :host    => 2,
+            :cluster => 3
+        }
+
         #######################################################################
         # Class constructor & Pool Methods
         #######################################################################
@@ -168,6 +178,17 @@ module OpenNebula
             xmlrpc_info(VM_POOL_METHODS[:info_set], vm_ids, extended)
         end
 
+        # Performs an action on a set of VMs in a single call
+        #
+        # @param [String] action name (e.g. 'poweroff', 'resume')
+        # @param [String] comma separated list of vm ids, it must not be empty
+        #
+        # @return [String, OpenNebula::Error] XML with the result of the
+        #   action for each VM, Error if the call fails
+        def action(action, vm_ids)
+            @client.call(VM_POOL_METHODS[:action], action, vm_ids)
+        end
+
         # Retrieves the monitoring data for all the VMs in the pool
         #
         # @param [Array<String>] xpath_expressions Elements to retrieve.
@@ -360,6 +381,36 @@ module OpenNebula
             xml_str
         end
 
+        # Retrieves the accounting totals for the VMs in the pool, computed
+        # by oned and aggregated by user, group, host or cluster. Only closed
+        # history records are accounted
+        #
+        # @param [Integer] filter_flag Optional filter flag to retrieve all or
+        #   part of the Pool. Possible values: INFO_ALL, INFO_GROUP, INFO_MINE
+        #   or user_id
+        # @param [Hash] options
+        # @option params [Symbol] :group_by One of :user, :group, :host or
+        #   :cluster, defaults to :user
+        # @option params [Integer] :start_time Start date and time to take into account,
+        #   if no start_time is required use -1
+        # @option params [Integer] :end_time End date and time to take into account,
+        #   if no end_time is required use -1
+        #
+        # @return [String] the xml representing the accounting totals
+        def accounting_totals(filter_flag=INFO_ALL, options={})
+            group_by = ACCT_GROUP_BY[options[:group_by] || :user]
+
+            if group_by.nil?
+                return OpenNebula::Error.new("Wrong group_by #{options[:group_by]}")
+            end
+
+            @client.call(VM_POOL_METHODS[:accounting_totals],
+                         filter_flag,
+                         group_by,
+                         options[:start_time] || -1,
+                         options[:end_time] || -1)
+        end
+
         # Retrieves the showback data for all the VMs in the pool
         #
         # @param [Integer] filter_flag Optional filter flag to retrieve all or
@@ -147,6 +147,12 @@ class OneDBBacKEnd
         },
         "7.4.0" => {
             group_vlans: "group_oid INTEGER PRIMARY KEY, body MEDIUMTEXT"
+        },
+        "7.6.0" => {
+            history_acct: "vid INTEGER, seq INTEGER, vm_uid INTEGER, " <<
+                "vm_gid INTEGER, hid INTEGER, cid INTEGER, stime INTEGER, " <<
+                "etime INTEGER, rstime INTEGER, retime INTEGER, cpu FLOAT, " <<
+                "memory BIGINT, disk BIGINT, PRIMARY KEY(vid,seq)"
         }
     }
 
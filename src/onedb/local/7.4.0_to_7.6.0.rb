@@ -35,9 +35,45 @@ module Migrator
     def up
         init_log_time
 
+        feature_history_acct
+
         log_time
 
         true
     end
 
+    # Numeric accounting data of the history records, used to aggregate
+    # accounting totals without parsing the history bodies
+    def feature_history_acct
+        create_table(:history_acct)
+
+        @db.transaction do
+            @db.fetch('SELECT vid, seq, body FROM history') do |row|
+                doc = nokogiri_doc(row[:body], 'history')
+
+                disk = doc.xpath('/HISTORY/VM/TEMPLATE/DISK/SIZE | ' \
+                                 '/HISTORY/VM/TEMPLATE/DISK/DISK_SNAPSHOT_TOTAL_SIZE')
+                          .inject(0) {|sum, e| sum + e.text.to_i }
+
+                @db[:history_acct].insert(
+                    :vid    => row[:vid],
+                    :seq    => row[:seq],
+                    :vm_uid => doc.xpath('/HISTORY/VM/UID').text.to_i,
+                    :vm_gid => doc.xpath('/HISTORY/VM/GID').text.to_i,
+                    :hid    => doc.xpath('/HISTORY/HID').text.to_i,
+                    :cid    => doc.xpath('/HISTORY/CID').text.to_i,
+                    :stime  => doc.xpath('/HISTORY/STIME').text.to_i,
+                    :etime  => doc.xpath('/HISTORY/ETIME').text.to_i,
+                    :rstime => doc.xpath('/HISTORY/RSTIME').text.to_i,
+                    :retime => doc.xpath('/HISTORY/RETIME').text.to_i,
+                    :cpu    => doc.xpath('/HISTORY/VM/TEMPLATE/CPU').text.to_f,
+                    :memory => doc.xpath('/HISTORY/VM/TEMPLATE/MEMORY').text.to_i,
+                    :disk   => disk
+                )
+            end
+        end
+
+        log_time
+    end
+
 end
@@ -249,6 +249,7 @@ class OneDBLive
         # Delete any history record that does not have the same
         # SEQ number as the last history record
         delete('history', "vid = #{vm.id} and seq >= #{start_seq} and seq <= #{end_seq}", false)
+        delete('history_acct', "vid = #{vm.id} and seq >= #{start_seq} and seq <= #{end_seq}", false)
 
         # Get VM history
         history = select('history', "vid = #{vm.id}")
@@ -270,6 +271,10 @@ class OneDBLive
             update('history',
                    { :seq => seq, :body => new_body },
                    "vid = #{vm.id} and seq = #{o_seq}", false)
+
+            update('history_acct',
+                   { :seq => seq },
+                   "vid = #{vm.id} and seq = #{o_seq}", false)
         end
     end
 
@@ -327,6 +332,7 @@ class OneDBLive
         # Delete any history record that does not have the same
         # SEQ number as the last history record
         delete('history', "vid = #{vm.id} and seq < #{seq_num}", false)
+        delete('history_acct', "vid = #{vm.id} and seq < #{seq_num}", false)
 
         # Get VM history
         history = select('history', "vid = #{vm.id}")
@@ -345,6 +351,10 @@ class OneDBLive
             update('history',
                    { :seq => index, :body => new_body },
                    "vid = #{vm.id} and seq = #{o_seq}", false)
+
+            update('history_acct',
+                   { :seq => index },
+                   "vid = #{vm.id} and seq = #{o_seq}", false)
         end
     end
 
@@ -367,6 +377,7 @@ class OneDBLive
 
             delete('vm_pool', "oid = #{obj['ID']}", false)
             delete('history', "vid = #{obj['ID']}", false)
+            delete('history_acct', "vid = #{obj['ID']}", false)
 
             true
         end
@@ -18,6 +18,7 @@ require 'opennebula'
 require 'prometheus/client'
 
 require_relative 'opennebula_server_collector'
+require_relative 'opennebula_oned_collector'
 require_relative 'opennebula_ha_collector'
 require_relative 'opennebula_host_collector'
 require_relative 'opennebula_datastore_collector'
@@ -80,6 +81,8 @@ module Prometheus
 
                 @collectors << OpenNebulaServerCollector.new(
                                       @registry, @client, NAMESPACE)
+                @collectors << OpenNebulaOnedCollector.new(
+                                      @registry, @client, NAMESPACE)
                 @collectors << OpenNebulaHostCollector.new(
                                       @registry, @client, NAMESPACE)
                 @collectors << OpenNebulaDatastoreCollector.new(
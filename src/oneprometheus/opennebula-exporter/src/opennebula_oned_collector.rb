@@ -0,0 +1,136 @@
+# -------------------------------------------------------------------------- #
+# Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                #
+#                                                                            #
+# Licensed under the Apache License, Version 2.0 (the "License"); you may    #
+# not use this file except in compliance with the License. You may obtain    #
+# a copy of the License at                                                   #
+#                                                                            #
+# http://www.apache.org/licenses/LICENSE-2.0                                 #
+#                                                                            #
+# Unless required by applicable law or agreed to in writing, software        #
+# distributed under the License is distributed on an "AS IS" BASIS,          #
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   #
+# See the License for the specific language governing permissions and        #
+# limitations under the License.                                             #
+#--------------------------------------------------------------------------- #
+
+require 'socket'
+
+# Internal oned metrics, from one.system.metrics. Latency histograms are
+# exported as the number of observations and the total time in seconds.
+class OpenNebulaOnedCollector
+
+    FQDN = Addrinfo.getaddrinfo(Socket.gethostname, nil).first.getnameinfo.first
+
+    # --------------------------------------------------------------------------
+    # oned metrics
+    # --------------------------------------------------------------------------
+    #   - opennebula_oned_rpc_count / opennebula_oned_rpc_seconds
+    #   - opennebula_oned_db_count / opennebula_oned_db_seconds
+    #   - opennebula_oned_raft_commit_count / opennebula_oned_raft_commit_seconds
+    #   - opennebula_oned_authorization_count / opennebula_oned_authorization_seconds
+    #   - opennebula_oned_listener_queue_depth
+    # --------------------------------------------------------------------------
+    HISTOGRAMS = {
+        'one_rpc_seconds' => {
+            :name   => 'oned_rpc',
+            :docstr => 'OpenNebula API calls',
+            :labels => %i[one_server_fqdn method phase]
+        },
+        'one_db_seconds' => {
+            :name   => 'oned_db',
+            :docstr => 'OpenNebula DB operations',
+            :labels => %i[one_server_fqdn op]
+        },
+        'one_raft_commit_seconds' => {
+            :name   => 'oned_raft_commit',
+            :docstr => 'OpenNebula Raft log commits',
+            :labels => %i[one_server_fqdn]
+        },
+        'one_authorization_seconds' => {
+            :name   => 'oned_authorization',
+            :docstr => 'OpenNebula authorization requests',
+            :labels => %i[one_server_fqdn]
+        }
+    }
+
+    GAUGES = {
+        'one_listener_queue_depth' => {
+            :name   => 'oned_listener_queue_depth',
+            :docstr => 'Pending events in the OpenNebula managers queues',
+            :labels => %i[one_server_fqdn listener]
+        },
+        'one_host_system_updates' => {
+            :name   => 'oned_host_system_updates',
+            :docstr => 'OpenNebula host monitoring updates written or skipped',
+            :labels => %i[one_server_fqdn result]
+        }
+    }
+
+    def initialize(registry, client, namespace)
+        @client  = client
+        @metrics = {}
+
+        HISTOGRAMS.each do |_key, conf|
+            @metrics["#{conf[:name]}_count"] = registry.gauge(
+                "#{namespace}_#{conf[:name]}_count".to_sym,
+                :docstring => "#{conf[:docstr]}, number of observations",
+                :labels    => conf[:labels]
+            )
+
+            @metrics["#{conf[:name]}_seconds"] = registry.gauge(
+                "#{namespace}_#{conf[:name]}_seconds".to_sym,
+                :docstring => "#{conf[:docstr]}, total time in seconds",
+                :labels    => conf[:labels]
+            )
+        end
+
+        GAUGES.each do |_key, conf|
+            @metrics[conf[:name]] = registry.gauge(
+                "#{namespace}_#{conf[:name]}".to_sym,
+                :docstring => conf[:docstr],
+                :labels    => conf[:labels]
+            )
+        end
+    end
+
+    def collect
+        metrics = OpenNebula::System.new(@client).get_metrics
+
+        return if OpenNebula.is_error?(metrics)
+
+        metrics.each('HISTOGRAM') do |h|
+            conf = HISTOGRAMS[h['NAME']]
+
+            next unless conf
+
+            labels = parse_labels(h['LABELS'])
+
+            @metrics["#{conf[:name]}_count"].set(h['COUNT'].to_i, :labels => labels)
+            @metrics["#{conf[:name]}_seconds"].set(h['SUM'].to_f, :labels => labels)
+        end
+
+        metrics.each('GAUGE') do |g|
+            conf = GAUGES[g['NAME']]
+
+            next unless conf
+
+            @metrics[conf[:name]].set(g['VALUE'].to_i,
+                                      :labels => parse_labels(g['LABELS']))
+        end
+    end
+
+    private
+
+    # Converts a label set (method="one.vm.info",phase="total") to a Hash
+    def parse_labels(str)
+        labels = { :one_server_fqdn => FQDN }
+
+        str.to_s.scan(/(\w+)="([^"]*)"/) do |key, value|
+            labels[key.to_sym] = value
+        end
+
+        labels
+    end
+
+end
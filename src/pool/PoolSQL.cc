@@ -188,14 +188,14 @@ int PoolSQL::dump(string& oss, const string& elem_name, const string& column,
         cmd << " " << db->limit_string(sid, eid);
     }
 
-    return dump(oss, elem_name, cmd);
+    return dump(oss, elem_name, cmd, eid == -1);
 }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 int PoolSQL::dump(string& oss, const string& root_elem_name,
-                  ostringstream& sql_query)
+                  ostringstream& sql_query, bool stream)
 {
     int rc;
 
@@ -212,6 +212,8 @@ int PoolSQL::dump(string& oss, const string& root_elem_name,
 
     cb.set_callback(&oss);
 
+    cb.set_stream(stream);
+
     rc = db->exec_rd(sql_query, &cb);
 
     cb.unset_callback();
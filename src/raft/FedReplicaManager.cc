@@ -28,6 +28,12 @@ using namespace std;
 
 const time_t FedReplicaManager::rpc_timeout_ms = 10000;
 
+const size_t FedReplicaManager::batch_max_records = 100;
+
+const size_t FedReplicaManager::batch_max_bytes = 1048576;
+
+const time_t FedReplicaManager::batch_retry = 600;
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -79,6 +85,37 @@ uint64_t FedReplicaManager::apply_log_record(uint64_t index, uint64_t prev,
     return 0;
 }
 
+/* -------------------------------------------------------------------------- */
+
+uint64_t FedReplicaManager::apply_log_records(uint64_t prev,
+                                              const std::vector<uint64_t>& indexes,
+                                              const std::vector<std::string>& sqls,
+                                              size_t& applied)
+{
+    lock_guard<mutex> ul(fed_mutex);
+
+    applied = 0;
+
+    uint64_t last_index = logdb->last_federated();
+
+    if ( prev != last_index )
+    {
+        return last_index;
+    }
+
+    for (; applied < indexes.size() && applied < sqls.size(); ++applied)
+    {
+        std::ostringstream oss(sqls[applied]);
+
+        if ( logdb->exec_federated_wr(oss, indexes[applied]) != 0 )
+        {
+            return UINT64_MAX;
+        }
+    }
+
+    return 0;
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -213,8 +250,9 @@ ReplicaThread * FedReplicaManager::thread_factory(int zone_id)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-int FedReplicaManager::get_next_record(int zone_id, std::string& zedp,
-                                       LogDBRecord& lr, std::string& error)
+int FedReplicaManager::get_next_records(int zone_id, std::string& zedp,
+                                        uint64_t& prev, std::vector<uint64_t>& indexes,
+                                        bool& batch, std::string& error)
 {
     lock_guard<mutex> ul(fed_mutex);
 
@@ -246,9 +284,9 @@ int FedReplicaManager::get_next_record(int zone_id, std::string& zedp,
         return -2;
     }
 
-    uint64_t prev_index = logdb->previous_federated(zs->next);
+    prev = logdb->previous_federated(zs->next);
 
-    if ( prev_index == UINT64_MAX )
+    if ( prev == UINT64_MAX )
     {
         std::ostringstream oss;
 
@@ -259,25 +297,39 @@ int FedReplicaManager::get_next_record(int zone_id, std::string& zedp,
         return -1;
     }
 
-    int rc = logdb->get_log_record(zs->next, prev_index, lr);
+    time_t the_time = time(nullptr);
 
-    if ( rc == -1 )
+    //Try batches again on zones that failed to process them
+    if ( !zs->batch && the_time >= zs->batch_time + batch_retry )
     {
-        std::ostringstream oss;
+        zs->batch = true;
+    }
 
-        oss << "Failed to load federation log record " << zs->next
-            << " for zone " << zs->zone_id;
+    batch = zs->batch;
 
-        error = oss.str();
+    size_t max_records = batch ? batch_max_records : 1;
+
+    for (uint64_t idx = zs->next; idx != UINT64_MAX && indexes.size() < max_records;
+         idx = logdb->next_federated(idx))
+    {
+        indexes.push_back(idx);
     }
 
-    return rc;
+    if ( zs->sync_start == 0 )
+    {
+        zs->sync_start   = the_time;
+        zs->sync_records = 0;
+        zs->sync_bytes   = 0;
+        zs->sync_rpcs    = 0;
+    }
+
+    return 0;
 }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void FedReplicaManager::replicate_success(int zone_id)
+void FedReplicaManager::replicate_success(int zone_id, uint64_t last)
 {
     lock_guard<mutex> ul(fed_mutex);
 
@@ -290,14 +342,33 @@ void FedReplicaManager::replicate_success(int zone_id)
 
     ZoneServers * zs = it->second;
 
-    zs->last = zs->next;
+    zs->last = last;
 
-    zs->next = logdb->next_federated(zs->next);
+    zs->next = logdb->next_federated(zs->last);
 
     if ( zs->next != UINT64_MAX )
     {
         ReplicaManager::replicate(zone_id);
+        return;
     }
+
+    if ( zs->sync_start == 0 )
+    {
+        return;
+    }
+
+    // Zone is up to date, report the catch-up statistics
+    std::ostringstream oss;
+
+    time_t elapsed = time(nullptr) - zs->sync_start;
+
+    oss << "Zone " << zone_id << " in sync at index " << zs->last << ": "
+        << zs->sync_records << " records (" << zs->sync_bytes << " bytes) in "
+        << zs->sync_rpcs << " calls, " << elapsed << "s";
+
+    NebulaLog::log("FRM", zs->sync_rpcs > 1 ? Log::INFO : Log::DDEBUG, oss);
+
+    zs->sync_start = 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -334,25 +405,80 @@ int FedReplicaManager::rpc_replicate_log(int zone_id, bool& success,
                                          uint64_t& last, std::string& error)
 {
     std::string zedp;
+    uint64_t    prev;
+    bool        batch;
 
-    LogDBRecord lr;
+    std::vector<uint64_t> indexes;
 
-    int rc = get_next_record(zone_id, zedp, lr, error);
+    int rc = get_next_records(zone_id, zedp, prev, indexes, batch, error);
 
     if ( rc != 0 )
     {
         return rc;
     }
 
-    uint64_t prev_index = logdb->previous_federated(lr.index);
+    // -------------------------------------------------------------------------
+    // Load the records, the batch is cut when it exceeds batch_max_bytes
+    // -------------------------------------------------------------------------
+    std::vector<std::string> sqls;
+
+    size_t bytes = 0;
+
+    uint64_t lr_prev = prev;
+
+    for (auto idx : indexes)
+    {
+        LogDBRecord lr;
+
+        if ( logdb->get_log_record(idx, lr_prev, lr) != 0 )
+        {
+            if ( sqls.empty() )
+            {
+                std::ostringstream oss;
+
+                oss << "Failed to load federation log record " << idx
+                    << " for zone " << zone_id;
+
+                error = oss.str();
+
+                return -1;
+            }
+
+            break;
+        }
+
+        bytes += lr.sql.size();
+
+        sqls.push_back(std::move(lr.sql));
+
+        lr_prev = idx;
+
+        if ( bytes >= batch_max_bytes )
+        {
+            break;
+        }
+    }
+
+    indexes.resize(sqls.size());
 
-    rc = Client::fed_replicate(zedp, lr.index, prev_index, lr.sql, rpc_timeout_ms, success, last, error);
+    if ( batch )
+    {
+        rc = Client::fed_replicate_batch(zedp, prev, indexes, sqls,
+                                         rpc_timeout_ms, success, last, error);
+    }
+    else
+    {
+        rc = Client::fed_replicate(zedp, indexes[0], prev, sqls[0],
+                                   rpc_timeout_ms, success, last, error);
+    }
+
+    rpc_stats(zone_id, rc, batch, sqls.size(), bytes);
 
     if ( rc != 0)
     {
         std::ostringstream ess;
 
-        ess << "Error replicating log entry " << lr.index << " on zone "
+        ess << "Error replicating log entry " << indexes[0] << " on zone "
             << zone_id << " (" << zedp << "): " << error;
 
         NebulaLog::log("FRM", Log::ERROR, ess);
@@ -363,3 +489,36 @@ int FedReplicaManager::rpc_replicate_log(int zone_id, bool& success,
     return rc;
 }
 
+/* -------------------------------------------------------------------------- */
+
+void FedReplicaManager::rpc_stats(int zone_id, int rc, bool batch,
+                                  size_t records, size_t bytes)
+{
+    lock_guard<mutex> ul(fed_mutex);
+
+    auto it = zones.find(zone_id);
+
+    if ( it == zones.end() )
+    {
+        return;
+    }
+
+    ZoneServers * zs = it->second;
+
+    zs->sync_rpcs++;
+
+    if ( rc == 0 )
+    {
+        zs->sync_records += records;
+        zs->sync_bytes   += bytes;
+    }
+    else if ( batch && rc == -2 )
+    {
+        // The zone does not implement one.zone.fedreplicatebatch (older
+        // version), use single record calls for a while. Other errors
+        // (e.g. timeouts) do not change the replication mode.
+        zs->batch      = false;
+        zs->batch_time = time(nullptr);
+    }
+}
+
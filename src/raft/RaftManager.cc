@@ -18,11 +18,17 @@
 #include "FedReplicaManager.h"
 #include "ZoneServer.h"
 #include "Client.h"
+#include "ClientPeers.h"
 #include "ZonePool.h"
 #include "LogDB.h"
 #include "AclManager.h"
 #include "Nebula.h"
 #include "InformationManager.h"
+#include "QuotaLedger.h"
+#include "HookLog.h"
+#include "SchedulerManager.h"
+#include "VirtualMachinePool.h"
+#include "HostPool.h"
 
 #include <cstdlib>
 
@@ -420,14 +426,37 @@ void RaftManager::leader()
 
     aclm->reload_rules();
 
+    nd.get_vmpool()->clear_vm_states();
+
+    nd.get_hpool()->reset_capacity();
+
+    if ( auto sm = nd.get_sm() )
+    {
+        sm->reset_delta();
+    }
+
     if ( nd.is_federation_master() )
     {
         frm->start_replica_threads();
     }
 
+    // Quotas are cached and VM search updates rebuilt once the DB includes
+    // the replicated log
+    auto start_leader = []()
+    {
+        Nebula& nd = Nebula::instance();
+
+        if ( auto qledger = nd.get_quota_ledger() )
+        {
+            qledger->start();
+        }
+
+        nd.get_vmpool()->rebuild_search();
+    };
+
     if ( _applied < index )
     {
-        std::thread t([this, _next_index]
+        std::thread t([this, _next_index, start_leader]
         {
             Nebula& nd = Nebula::instance();
 
@@ -439,6 +468,8 @@ void RaftManager::leader()
 
             NebulaLog::log("RCM", Log::INFO, "Leader log replicated");
 
+            start_leader();
+
             std::lock_guard<mutex> lock(raft_mutex);
 
             reconciling = false;
@@ -446,6 +477,10 @@ void RaftManager::leader()
 
         t.detach();
     }
+    else
+    {
+        start_leader();
+    }
 
     NebulaLog::log("RCM", Log::INFO, "oned is now the leader of the zone");
 }
@@ -509,6 +544,22 @@ void RaftManager::follower(unsigned int _term)
         frm->stop_replica_threads();
     }
 
+    if ( auto qledger = nd.get_quota_ledger() )
+    {
+        qledger->stop();
+    }
+
+    nd.get_vmpool()->clear_vm_states();
+
+    nd.get_vmpool()->clear_search();
+
+    if ( auto hl = nd.get_hl() )
+    {
+        hl->reset();
+    }
+
+    nd.get_hpool()->reset_capacity();
+
     if (!raft_state_xml.empty())
     {
         logdb->update_raft_state(raft_state_name, raft_state_xml);
@@ -1102,6 +1153,10 @@ std::string& RaftManager::to_xml(std::string& raft_xml)
         oss << "<FEDLOG_INDEX>-1</FEDLOG_INDEX>";
     }
 
+    std::string peers_xml;
+
+    oss << ClientPeers::instance().to_xml(peers_xml);
+
     oss << "</RAFT>";
 
     raft_xml = oss.str();
@@ -237,7 +237,7 @@ int FedReplicaThread::replicate()
 
     if ( success )
     {
-        frm->replicate_success(follower_id);
+        frm->replicate_success(follower_id, last);
     }
     else
     {
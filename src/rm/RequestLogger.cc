@@ -85,6 +85,11 @@ void RequestLogger::log_method_invoked(const RequestAttributes& att,
                                        const ParamList& pl,
                                        const std::string& method_name)
 {
+    if ( NebulaLog::log_level() < Log::DEBUG )
+    {
+        return;
+    }
+
     std::ostringstream oss;
     std::ostringstream oss_limit;
 
@@ -37,4 +37,54 @@ Request::ErrorCode HostPoolAPI::monitoring(int seconds, string& xml, RequestAttr
     }
 
     return Request::SUCCESS;
-}
\ No newline at end of file
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Request::ErrorCode HostPoolAPI::capacity(uint64_t epoch,
+                                         uint64_t since,
+                                         string& xml,
+                                         RequestAttributes& att)
+{
+    string where;
+
+    where_filter(att, PoolSQL::ALL, -1, -1, "", "", false, false, false, where);
+
+    vector<HostPool::Capacity> records;
+
+    uint64_t version = hpool->get_capacity(epoch, since, records);
+
+    if ( !where.empty() )
+    {
+        vector<int> oids;
+
+        if ( hpool->search(oids, where) != 0 )
+        {
+            att.resp_msg = "Internal error";
+
+            return Request::INTERNAL;
+        }
+
+        set<int> allowed(oids.begin(), oids.end());
+
+        auto it = records.begin();
+
+        while ( it != records.end() )
+        {
+            // Deleted hosts are not in the DB, keep them to notify the client
+            if ( it->state != -1 && allowed.count(it->oid) == 0 )
+            {
+                it = records.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    HostPool::capacity_to_xml(epoch, version, records, xml);
+
+    return Request::SUCCESS;
+}
@@ -42,8 +42,27 @@ protected:
                                   std::string& xml,
                                   RequestAttributes& att);
 
+    Request::ErrorCode capacity(uint64_t epoch,
+                                uint64_t since,
+                                std::string& xml,
+                                RequestAttributes& att);
+
     /* Helpers */
     HostPool* hpool;
 };
 
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
+class HostPoolCapacityAPI : public HostPoolAPI
+{
+protected:
+    HostPoolCapacityAPI(Request &r)
+        : HostPoolAPI(r)
+    {
+        // The capacity snapshot is only kept by the leader
+        request.leader_only(true);
+    }
+};
+
 #endif
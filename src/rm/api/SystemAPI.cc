@@ -173,3 +173,34 @@ Request::ErrorCode SystemAPI::sql_query(std::string& sql, RequestAttributes& att
 
     return Request::SUCCESS;
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Request::ErrorCode SystemAPI::metrics(int format, std::string& metrics_str,
+                                      RequestAttributes& att)
+{
+    if (!att.is_admin())
+    {
+        att.resp_id = -1;
+
+        return Request::AUTHORIZATION;
+    }
+
+    switch (format)
+    {
+        case 0:
+            metrics_str = Metrics::instance().to_xml();
+            break;
+
+        case 1:
+            metrics_str = Metrics::instance().to_prometheus();
+            break;
+
+        default:
+            att.resp_msg = "Wrong metrics format, use 0 (XML) or 1 (Prometheus)";
+            return Request::RPC_API;
+    }
+
+    return Request::SUCCESS;
+}
@@ -46,6 +46,13 @@ protected:
 
     Request::ErrorCode sql_query(std::string& sql, RequestAttributes& att);
 
+    /**
+     *  Internal metrics of this oned server
+     *    @param format 0 XML, 1 Prometheus text format
+     */
+    Request::ErrorCode metrics(int format, std::string& metrics_str,
+                               RequestAttributes& att);
+
     /* Helpers */
     class select_cb : public Callbackable
     {
@@ -95,4 +102,18 @@ protected:
     }
 };
 
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+class SystemMetricsAPI : public SystemAPI
+{
+protected:
+    SystemMetricsAPI(Request &r) : SystemAPI(r)
+    {
+        // Metrics are local to each server, followers do not forward the call
+        request.leader_only(false);
+        request.zone_disabled(true);
+    }
+};
+
 #endif
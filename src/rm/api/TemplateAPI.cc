@@ -20,6 +20,8 @@
 #include "VirtualMachinePool.h"
 #include "ScheduledActionPool.h"
 #include "ImageAPI.h"
+#include "DispatchManager.h"
+#include "QuotaLedger.h"
 
 using namespace std;
 
@@ -33,6 +35,31 @@ Request::ErrorCode TemplateAPI::instantiate(int oid,
                                             bool persistent,
                                             int& vid,
                                             RequestAttributes& att)
+{
+    vector<int> vids;
+
+    auto ec = instantiate(oid, name, hold, str_extra_tmpl, persistent, 1, vids,
+                          att);
+
+    if ( ec == Request::SUCCESS )
+    {
+        vid = vids[0];
+    }
+
+    return ec;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Request::ErrorCode TemplateAPI::instantiate(int oid,
+                                            const string& name,
+                                            bool hold,
+                                            string str_extra_tmpl,
+                                            bool persistent,
+                                            int n_vms,
+                                            vector<int>& vids,
+                                            RequestAttributes& att)
 {
     att.auth_op = AuthRequest::USE;
 
@@ -59,6 +86,14 @@ Request::ErrorCode TemplateAPI::instantiate(int oid,
         return Request::ACTION;
     }
 
+    // The persistent copy and its images can only be used by one VM
+    if (persistent && n_vms > 1)
+    {
+        att.resp_msg = "Persistent instantiation is limited to one VM";
+
+        return Request::ACTION;
+    }
+
     int instantiate_id = oid;
 
     if (persistent)
@@ -89,7 +124,8 @@ Request::ErrorCode TemplateAPI::instantiate(int oid,
         str_extra_tmpl = oss.str();
     }
 
-    return instantiate_helper(instantiate_id, name, hold, str_extra_tmpl, 0, vid, att);
+    return instantiate_helper(instantiate_id, name, hold, str_extra_tmpl, 0,
+                              n_vms, vids, att);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -319,12 +355,38 @@ Request::ErrorCode TemplateAPI::instantiate_helper(int oid,
                                                    Template* extra_tmpl,
                                                    int& vid,
                                                    RequestAttributes& att)
+{
+    vector<int> vids;
+
+    auto ec = instantiate_helper(oid, name, on_hold, str_uattrs, extra_tmpl, 1,
+                                 vids, att);
+
+    if ( ec == Request::SUCCESS )
+    {
+        vid = vids[0];
+    }
+
+    return ec;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Request::ErrorCode TemplateAPI::instantiate_helper(int oid,
+                                                   const std::string& name,
+                                                   bool on_hold,
+                                                   const std::string& str_uattrs,
+                                                   Template* extra_tmpl,
+                                                   int n_vms,
+                                                   std::vector<int>& vids,
+                                                   RequestAttributes& att)
 {
     PoolObjectAuth perms;
 
     Nebula& nd = Nebula::instance();
 
     VirtualMachinePool* vmpool  = nd.get_vmpool();
+    DispatchManager*    dm      = nd.get_dm();
 
     unique_ptr<VirtualMachineTemplate> tmpl;
     VirtualMachineTemplate extended_tmpl;
@@ -332,6 +394,15 @@ Request::ErrorCode TemplateAPI::instantiate_helper(int oid,
 
     string tmpl_name;
 
+    vids.clear();
+
+    if ( n_vms <= 0 )
+    {
+        att.resp_msg = "Number of VMs to instantiate must be greater than 0";
+
+        return Request::ACTION;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* Get, check and clone the template                                      */
     /* ---------------------------------------------------------------------- */
@@ -418,45 +489,128 @@ Request::ErrorCode TemplateAPI::instantiate_helper(int oid,
         return Request::AUTHORIZATION;
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* Reserve the quotas of all the VMs before allocating any of them        */
+    /* ---------------------------------------------------------------------- */
     extended_tmpl.update_quota_attributes();
 
     QuotaVirtualMachine::add_running_quota_generic(extended_tmpl);
 
-    if (!quota_authorization(&extended_tmpl, Quotas::VIRTUALMACHINE, att, att.resp_msg))
+    vector<unique_ptr<Template>> ds_quotas;
+
+    VirtualMachineDisks::image_ds_quotas(&extended_tmpl, ds_quotas);
+
+    // Reservations of the VM and datastore quotas, each VM commits its share
+    // when allocated and the rest is released on error. Without a ledger
+    // (cache server) the quotas of each VM are checked one by one.
+    QuotaLedger * qledger = nd.get_quota_ledger();
+
+    vector<int> rids;
+
+    int reserved = 0;
+
+    auto quota_add = [&]()
     {
-        return Request::AUTHORIZATION;
-    }
+        if (!quota_authorization(&extended_tmpl, Quotas::VIRTUALMACHINE, att,
+                                 att.resp_msg))
+        {
+            return false;
+        }
 
-    bool ds_quota_auth = true;
+        for (size_t i = 0; i < ds_quotas.size(); ++i)
+        {
+            if (!quota_authorization(ds_quotas[i].get(), Quotas::DATASTORE, att,
+                                     att.resp_msg))
+            {
+                quota_rollback(&extended_tmpl, Quotas::VIRTUALMACHINE, att);
 
-    vector<unique_ptr<Template>> ds_quotas;
-    vector<unique_ptr<Template>> applied;
+                for (size_t j = 0; j < i; ++j)
+                {
+                    quota_rollback(ds_quotas[j].get(), Quotas::DATASTORE, att);
+                }
 
-    VirtualMachineDisks::image_ds_quotas(&extended_tmpl, ds_quotas);
+                return false;
+            }
+        }
+
+        return true;
+    };
 
-    for ( auto& ds : ds_quotas )
+    auto quota_commit = [&]()
     {
-        if ( !quota_authorization(ds.get(), Quotas::DATASTORE, att, att.resp_msg) )
+        if ( qledger == nullptr )
         {
-            ds_quota_auth = false;
-            break;
+            reserved--;
+            return;
         }
-        else
+
+        for (auto rid : rids)
         {
-            applied.push_back(move(ds));
+            qledger->commit(rid);
         }
-    }
+    };
 
-    if ( ds_quota_auth == false )
+    auto quota_release = [&]()
     {
-        quota_rollback(&extended_tmpl, Quotas::VIRTUALMACHINE, att);
+        if ( qledger == nullptr )
+        {
+            for (; reserved > 0; --reserved)
+            {
+                quota_rollback(&extended_tmpl, Quotas::VIRTUALMACHINE, att);
+
+                for ( auto& ds : ds_quotas )
+                {
+                    quota_rollback(ds.get(), Quotas::DATASTORE, att);
+                }
+            }
 
-        for ( auto& ds : applied )
+            return;
+        }
+
+        for (auto rid : rids)
         {
-            quota_rollback(ds.get(), Quotas::DATASTORE, att);
+            qledger->rollback(rid);
         }
+    };
 
-        return Request::AUTHORIZATION;
+    if ( qledger == nullptr )
+    {
+        for (; reserved < n_vms; ++reserved)
+        {
+            if (!quota_add())
+            {
+                quota_release();
+
+                return Request::AUTHORIZATION;
+            }
+        }
+    }
+    else
+    {
+        int rid = qledger->reserve(att.uid, att.gid, Quotas::VIRTUALMACHINE,
+                                   &extended_tmpl, n_vms, att.resp_msg);
+
+        if ( rid == -1 )
+        {
+            return Request::AUTHORIZATION;
+        }
+
+        rids.push_back(rid);
+
+        for ( auto& ds : ds_quotas )
+        {
+            rid = qledger->reserve(att.uid, att.gid, Quotas::DATASTORE,
+                                   ds.get(), n_vms, att.resp_msg);
+
+            if ( rid == -1 )
+            {
+                quota_release();
+
+                return Request::AUTHORIZATION;
+            }
+
+            rids.push_back(rid);
+        }
     }
 
     /* ---------------------------------------------------------------------- */
@@ -466,83 +620,127 @@ Request::ErrorCode TemplateAPI::instantiate_helper(int oid,
 
     tmpl->remove("SCHED_ACTION", sas);
 
-    int rc = vmpool->allocate(att.uid, att.gid, att.uname, att.gname, att.umask,
-                              move(tmpl), &vid, att.resp_msg, on_hold);
+    auto sapool = nd.get_sapool();
+
+    time_t stime = time(0);
 
-    if ( rc < 0 )
+    // The VMs of a batch are allocated on hold and released when all of them
+    // are created, so the scheduler does not deploy a partial batch
+    bool batch_hold = on_hold || n_vms > 1;
+
+    for (int i = 0; i < n_vms; ++i)
     {
-        quota_rollback(&extended_tmpl, Quotas::VIRTUALMACHINE, att);
+        string error;
+
+        unique_ptr<VirtualMachineTemplate> vm_tmpl;
 
-        for ( auto& ds : applied )
+        if ( i == n_vms - 1 )
         {
-            quota_rollback(ds.get(), Quotas::DATASTORE, att);
+            vm_tmpl = move(tmpl);
+        }
+        else
+        {
+            vm_tmpl = make_unique<VirtualMachineTemplate>(*tmpl);
         }
 
-        return Request::ALLOCATE;
-    }
+        if (!name.empty() && n_vms > 1)
+        {
+            vm_tmpl->replace("NAME", one_util::gsub(name, "%i", to_string(i)));
+        }
 
-    /* ---------------------------------------------------------------------- */
-    /* Create ScheduleAction and associate to the VM                          */
-    /* ---------------------------------------------------------------------- */
-    auto sapool = Nebula::instance().get_sapool();
+        int vid;
 
-    time_t stime  = time(0);
-    bool sa_error = false;
+        int rc = vmpool->allocate(att.uid, att.gid, att.uname, att.gname,
+                                  att.umask, move(vm_tmpl), &vid, att.resp_msg,
+                                  batch_hold);
 
-    std::vector<int> sa_ids;
+        if ( rc < 0 )
+        {
+            quota_release();
 
-    for (const auto& sa : sas)
-    {
-        int sa_id = sapool->allocate(PoolObjectSQL::VM, vid, stime, sa.get(), att.resp_msg);
+            for (auto id : vids)
+            {
+                dm->delete_vm(id, att, error);
+            }
 
-        if (sa_id < 0)
-        {
-            sa_error = true;
-            break;
+            vids.clear();
+
+            return Request::ALLOCATE;
         }
 
-        sa_ids.push_back(sa_id);
-    }
+        vids.push_back(vid);
 
-    /* ---------------------------------------------------------------------- */
-    /* Error creating a SCHED_ACTION rollback created objects                 */
-    /* ---------------------------------------------------------------------- */
-    if (sa_error)
-    {
-        // Consistency check, the VM template should not have parsing errors
-        // of Scheduled Actions at this point.
-        sapool->drop_sched_actions(sa_ids);
+        quota_commit();
 
-        // Test the rollback quota, not sure if it's correct
-        quota_rollback(&extended_tmpl, Quotas::VIRTUALMACHINE, att);
+        /* ------------------------------------------------------------------ */
+        /* Create ScheduleAction and associate to the VM                      */
+        /* ------------------------------------------------------------------ */
+        std::vector<int> sa_ids;
 
-        for ( auto& ds : applied )
+        bool sa_error = false;
+
+        for (const auto& sa : sas)
         {
-            quota_rollback(ds.get(), Quotas::DATASTORE, att);
-        }
+            int sa_id = sapool->allocate(PoolObjectSQL::VM, vid, stime, sa.get(),
+                                         att.resp_msg);
 
-        return Request::INTERNAL;
-    }
+            if (sa_id < 0)
+            {
+                sa_error = true;
+                break;
+            }
 
-    /* ---------------------------------------------------------------------- */
-    /* Associate SCHED_ACTIONS to the VM                                      */
-    /* ---------------------------------------------------------------------- */
-    if ( auto vm = vmpool->get(vid) )
-    {
-        for (const auto sa_id: sa_ids)
+            sa_ids.push_back(sa_id);
+        }
+
+        if ( !sa_error )
         {
-            vm->sched_actions().add(sa_id);
+            if ( auto vm = vmpool->get(vid) )
+            {
+                for (const auto sa_id: sa_ids)
+                {
+                    vm->sched_actions().add(sa_id);
+                }
+
+                vmpool->update(vm.get());
+            }
+            else
+            {
+                att.resp_msg = "VM deleted while setting up SCHED_ACTION";
+
+                sa_error = true;
+            }
         }
 
-        vmpool->update(vm.get());
-    }
-    else
-    {
-        att.resp_msg = "VM deleted while setting up SCHED_ACTION";
+        /* ------------------------------------------------------------------ */
+        /* Error creating a SCHED_ACTION rollback created objects             */
+        /* ------------------------------------------------------------------ */
+        if (sa_error)
+        {
+            // Consistency check, the VM template should not have parsing
+            // errors of Scheduled Actions at this point.
+            sapool->drop_sched_actions(sa_ids);
 
-        sapool->drop_sched_actions(sa_ids);
+            // Quotas of the allocated VMs are released by delete_vm
+            quota_release();
 
-        return Request::INTERNAL;
+            for (auto id : vids)
+            {
+                dm->delete_vm(id, att, error);
+            }
+
+            vids.clear();
+
+            return Request::INTERNAL;
+        }
+    }
+
+    if ( batch_hold && !on_hold )
+    {
+        for (auto id : vids)
+        {
+            dm->release(id, att, att.resp_msg);
+        }
     }
 
     return Request::SUCCESS;
@@ -46,6 +46,23 @@ public:
                                           int& vid,
                                           RequestAttributes& att);
 
+    /**
+     *  Instantiates n_vms VMs from the template. The template is parsed,
+     *  merged and authorized once, and the quotas of all the VMs are reserved
+     *  before allocating them. If any VM fails the created VMs are deleted.
+     *    @param name of the VMs, "%i" is replaced by the VM index in the batch
+     *    @param n_vms number of VMs to create
+     *    @param vids IDs of the new VMs
+     */
+    Request::ErrorCode instantiate_helper(int oid,
+                                          const std::string& name,
+                                          bool on_hold,
+                                          const std::string& str_uattrs,
+                                          Template* extra_tmpl,
+                                          int n_vms,
+                                          std::vector<int>& vids,
+                                          RequestAttributes& att);
+
 protected:
     /* API calls */
     Request::ErrorCode instantiate(int oid,
@@ -56,6 +73,15 @@ protected:
                                    int& vid,
                                    RequestAttributes& att);
 
+    Request::ErrorCode instantiate(int oid,
+                                   const std::string& name,
+                                   bool hold,
+                                   std::string extra_tmpl,
+                                   bool persistent,
+                                   int n_vms,
+                                   std::vector<int>& vids,
+                                   RequestAttributes& att);
+
     Request::ErrorCode clone(int source_id,
                              const std::string& name,
                              bool recursive,
@@ -26,6 +26,8 @@
 #include "DispatchManager.h"
 #include "VirtualMachineManager.h"
 #include "ScopeGuard.h"
+#include "HookAPI.h"
+#include "HookManager.h"
 #include <functional>
 
 using namespace std;
@@ -859,6 +861,145 @@ Request::ErrorCode VirtualMachineAPI::action(int vid,
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+namespace
+{
+    /**
+     *  Parameters of an equivalent one.vm.action call, used to trigger the
+     *  API hooks of each VM processed by one.vmpool.action
+     */
+    class ParamListVMAction : public ParamList
+    {
+    public:
+        ParamListVMAction(const std::string& session,
+                          const std::string& action,
+                          int vid)
+            : ParamList({0})
+            , values{session, action, std::to_string(vid)}
+        {}
+
+        unsigned int size() const override
+        {
+            return values.size();
+        }
+
+    protected:
+        std::string api_value(int index) const override
+        {
+            return values[index];
+        }
+
+    private:
+        std::vector<std::string> values;
+    };
+}
+
+void VirtualMachineAPI::trigger_action_hook(const std::string& action_str,
+                                            int vid,
+                                            Request::ErrorCode ec,
+                                            RequestAttributes& att)
+{
+    Nebula& nd = Nebula::instance();
+
+    if (nd.is_cache())
+    {
+        return;
+    }
+
+    ParamListVMAction pl(att.session, action_str, vid);
+
+    ostringstream oss;
+
+    // Same output parameters as the one.vm.action response
+    oss << "<PARAMETER><POSITION>1</POSITION><TYPE>OUT</TYPE>"
+        << "<VALUE>" << (ec == Request::SUCCESS ? "true" : "false")
+        << "</VALUE></PARAMETER>"
+        << "<PARAMETER><POSITION>2</POSITION><TYPE>OUT</TYPE>"
+        << "<VALUE>" << vid << "</VALUE></PARAMETER>"
+        << "<PARAMETER><POSITION>3</POSITION><TYPE>OUT</TYPE>"
+        << "<VALUE>" << ec << "</VALUE></PARAMETER>";
+
+    if ( ec != Request::SUCCESS )
+    {
+        oss << "<PARAMETER><POSITION>4</POSITION><TYPE>OUT</TYPE>"
+            << "<VALUE>" << att.resp_id << "</VALUE></PARAMETER>";
+    }
+
+    att.success    = ec == Request::SUCCESS;
+    att.retval_xml = oss.str();
+
+    std::string event = HookAPI::format_message("one.vm.action", pl, att);
+
+    if (!event.empty())
+    {
+        nd.get_hm()->trigger_send_event(event);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Request::ErrorCode VirtualMachineAPI::pool_action(const std::string& action_str,
+                                                  const std::string& ids_str,
+                                                  std::string& xml,
+                                                  RequestAttributes& att)
+{
+    VMActions::Action action;
+
+    std::set<int> ids;
+
+    if (VMActions::action_from_str(action_str, action) != 0)
+    {
+        att.resp_msg = "Action \"" + action_str + "\" is not supported";
+        return Request::ACTION;
+    }
+
+    one_util::split_unique(ids_str, ',', ids);
+
+    if (ids.empty())
+    {
+        att.resp_msg = "No VM IDs given";
+        return Request::RPC_API;
+    }
+
+    // Each VM uses its own attributes, the authorization level and the
+    // response of a VM must not leak to the next one
+    ostringstream oss;
+
+    oss << "<VM_ACTION_RESULTS>";
+
+    for (auto vid : ids)
+    {
+        RequestAttributes vm_att(att);
+
+        vm_att.resp_obj = PoolObjectSQL::NONE;
+        vm_att.resp_id  = -1;
+        vm_att.resp_msg.clear();
+
+        auto ec = this->action(vid, action_str, vm_att);
+
+        trigger_action_hook(action_str, vid, ec, vm_att);
+
+        oss << "<VM>"
+            << "<ID>" << vid << "</ID>"
+            << "<SUCCESS>" << (ec == Request::SUCCESS) << "</SUCCESS>"
+            << "<ERROR_CODE>" << ec << "</ERROR_CODE>"
+            << "<MESSAGE>"
+            << one_util::escape_xml(Request::failure_message(ec, vm_att,
+                    request.method_name(), PoolObjectSQL::VM))
+            << "</MESSAGE>"
+            << "</VM>";
+    }
+
+    oss << "</VM_ACTION_RESULTS>";
+
+    xml = oss.str();
+
+    return Request::SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Request::ErrorCode VirtualMachineAPI::migrate(int vid,
                                               int hid,
                                               bool live,
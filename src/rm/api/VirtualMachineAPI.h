@@ -50,6 +50,19 @@ public:
                               const std::string& action_str,
                               RequestAttributes& att);
 
+    /**
+     *  Performs an action on a set of VMs. The user is authenticated once
+     *  for the call, each VM is authorized and processed independently. The
+     *  one.vm.action API hooks are triggered for each VM.
+     *    @param action_str name of the action
+     *    @param ids_str comma separated list of VM IDs, it must not be empty
+     *    @param xml the result of the action for each VM
+     */
+    Request::ErrorCode pool_action(const std::string& action_str,
+                                   const std::string& ids_str,
+                                   std::string& xml,
+                                   RequestAttributes& att);
+
     Request::ErrorCode migrate(int vid,
                                int hid,
                                bool live,
@@ -285,6 +298,12 @@ protected:
                     VirtualMachine* vm,
                     std::string& error);
 
+    // Trigger the one.vm.action API hooks for a VM processed by pool_action
+    void trigger_action_hook(const std::string& action_str,
+                             int vid,
+                             Request::ErrorCode ec,
+                             RequestAttributes& att);
+
     int add_history(VirtualMachine *   vm,
                     int                hid,
                     int                cid,
@@ -223,6 +223,49 @@ Request::ErrorCode VirtualMachinePoolAPI::accounting(int filter_flag,
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+Request::ErrorCode VirtualMachinePoolAPI::accounting_totals(int filter_flag,
+                                                            int group_by,
+                                                            int64_t time_start,
+                                                            int64_t time_end,
+                                                            std::string& xml,
+                                                            RequestAttributes& att)
+{
+    string where;
+
+    if ( filter_flag < PoolSQL::GROUP )
+    {
+        att.resp_msg = "Incorrect filter_flag";
+
+        return Request::RPC_API;
+    }
+
+    if ( group_by < VirtualMachinePool::ACCT_USER ||
+         group_by > VirtualMachinePool::ACCT_CLUSTER )
+    {
+        att.resp_msg = "Incorrect group_by " + to_string(group_by);
+
+        return Request::RPC_API;
+    }
+
+    where_filter(att, filter_flag, -1, -1, "", "", false, false, false, where);
+
+    int rc = vmpool->dump_acct_totals(xml, where,
+                                      static_cast<VirtualMachinePool::AcctGroupBy>(group_by),
+                                      time_start, time_end);
+
+    if ( rc != 0 )
+    {
+        att.resp_msg = "Internal error";
+
+        return Request::INTERNAL;
+    }
+
+    return Request::SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Request::ErrorCode VirtualMachinePoolShowbackCalculateAPI::showback_calc(int start_month,
                                                                          int start_year,
                                                                          int end_month,
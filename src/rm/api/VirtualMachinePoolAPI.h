@@ -71,6 +71,13 @@ protected:
                                   std::string& xml,
                                   RequestAttributes& att);
 
+    Request::ErrorCode accounting_totals(int filter_flag,
+                                         int group_by,
+                                         int64_t time_start,
+                                         int64_t time_end,
+                                         std::string& xml,
+                                         RequestAttributes& att);
+
     Request::ErrorCode showback_list(int filter_flag,
                                      int start_month,
                                      int start_year,
@@ -103,13 +103,10 @@ Request::ErrorCode VirtualRouterAPI::instantiate(int oid,
     VMTemplatePool*  tpool = nd.get_tpool();
 
     PoolObjectAuth vr_perms;
-    string         vr_name, tmp_name;
-    ostringstream  oss;
+    string         vr_name;
 
     vector<int> vms;
 
-    int vid;
-
     std::unique_ptr<Template> extra_attrs;
 
     /* ---------------------------------------------------------------------- */
@@ -179,29 +176,22 @@ Request::ErrorCode VirtualRouterAPI::instantiate(int oid,
         name = "vr-" + vr_name + "-%i";
     }
 
-    Request r("internal call");
-    TemplateAPI tpl_api(r);
-
-    for (int i=0; i<n_vms; oss.str(""), i++)
+    if (n_vms == 1)
     {
-        oss << i;
-
-        tmp_name = one_util::gsub(name, "%i", oss.str());
-
-        Request::ErrorCode ec = tpl_api.instantiate_helper(template_id, tmp_name, true,
-                                                           str_uattrs, extra_attrs.get(), vid, att);
+        name = one_util::gsub(name, "%i", "0");
+    }
 
-        if (ec != Request::SUCCESS)
-        {
-            for (auto vmid : vms)
-            {
-                dm->delete_vm(vmid, att, att.resp_msg);
-            }
+    Request r("internal call");
+    TemplateAPI tpl_api(r);
 
-            return ec;
-        }
+    // The template is processed once for all the VMs, the helper deletes the
+    // VMs already created if any of them fails
+    Request::ErrorCode ec = tpl_api.instantiate_helper(template_id, name, true,
+                                                       str_uattrs, extra_attrs.get(), n_vms, vms, att);
 
-        vms.push_back(vid);
+    if (ec != Request::SUCCESS)
+    {
+        return ec;
     }
 
     if (auto vr = vrpool->get(oid))
@@ -659,3 +659,99 @@ Request::ErrorCode ZoneAPI::replicate_fed_log(uint64_t index,
 
     return Request::REPLICATION;
 }
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
+Request::ErrorCode ZoneAPI::replicate_fed_log_batch(uint64_t prev,
+                                                    const std::vector<uint64_t>& indexes,
+                                                    const std::vector<std::string>& sqls,
+                                                    RequestAttributes& att)
+{
+    std::ostringstream oss;
+
+    Nebula& nd = Nebula::instance();
+
+    FedReplicaManager * frm = nd.get_frm();
+
+    if (!att.is_oneadmin())
+    {
+        att.replication_idx  = UINT64_MAX;
+
+        return Request::AUTHORIZATION;
+    }
+
+    if ( nd.is_cache() )
+    {
+        att.resp_msg = "Server is in cache mode.";
+        att.replication_idx  = UINT64_MAX;
+
+        return Request::ACTION;
+    }
+
+    if ( indexes.empty() || indexes.size() != sqls.size() )
+    {
+        oss << "Received a malformed batch of " << indexes.size()
+            << " log entries and " << sqls.size() << " SQL commands";
+
+        NebulaLog::log("ReM", Log::ERROR, oss);
+
+        att.resp_msg = oss.str();
+        att.replication_idx  = UINT64_MAX;
+
+        return Request::REPLICATION;
+    }
+
+    for (size_t i = 0; i < sqls.size(); ++i)
+    {
+        if ( sqls[i].empty() )
+        {
+            oss << "Received an empty SQL command at index" << indexes[i];
+
+            NebulaLog::log("ReM", Log::ERROR, oss);
+
+            att.resp_msg = oss.str();
+            att.replication_idx  = UINT64_MAX;
+
+            return Request::REPLICATION;
+        }
+    }
+
+    if ( !nd.is_federation_slave() )
+    {
+        oss << "Cannot replicate federate log records on federation master";
+
+        NebulaLog::log("ReM", Log::INFO, oss);
+
+        att.resp_msg = oss.str();
+        att.replication_idx  = UINT64_MAX;
+
+        return Request::REPLICATION;
+    }
+
+    size_t applied;
+
+    uint64_t rc = frm->apply_log_records(prev, indexes, sqls, applied);
+
+    if ( rc == 0 )
+    {
+        att.replication_idx = indexes.back();
+        return Request::SUCCESS;
+    }
+
+    if ( rc == UINT64_MAX )
+    {
+        oss << "Error replicating log entry " << indexes[applied] << " in zone";
+        att.replication_idx  = indexes[applied];
+    }
+    else // rc == last_index in log
+    {
+        oss << "Zone log is outdated last log index is " << rc;
+        att.replication_idx  = rc;
+    }
+
+    NebulaLog::log("ReM", Log::INFO, oss);
+    att.resp_msg = oss.str();
+
+    return Request::REPLICATION;
+}
@@ -93,6 +93,11 @@ protected:
                                          std::string sql,
                                          RequestAttributes& att);
 
+    Request::ErrorCode replicate_fed_log_batch(uint64_t prev,
+                                               const std::vector<uint64_t>& indexes,
+                                               const std::vector<std::string>& sqls,
+                                               RequestAttributes& att);
+
     /* Helpers */
     int drop(std::unique_ptr<PoolObjectSQL> obj,
              bool recursive,
@@ -82,6 +82,13 @@ grpc::Status HostService::PoolMonitoring(grpc::ServerContext* context,
     return HostPoolMonitoringGRPC().execute(context, request, response);
 }
 
+grpc::Status HostService::PoolCapacity(grpc::ServerContext* context,
+                                       const one::host::PoolCapacityRequest* request,
+                                       one::ResponseXML* response)
+{
+    return HostPoolCapacityGRPC().execute(context, request, response);
+}
+
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
@@ -236,3 +243,17 @@ void HostPoolMonitoringGRPC::request_execute(const google::protobuf::Message* _r
     response(ec, xml, att);
 }
 
+/* ------------------------------------------------------------------------- */
+
+void HostPoolCapacityGRPC::request_execute(const google::protobuf::Message* _request,
+                                           google::protobuf::Message*       _response,
+                                           RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::host::PoolCapacityRequest*>(_request);
+
+    std::string xml;
+
+    auto ec = capacity(request->epoch(), request->version(), xml, att);
+
+    response(ec, xml, att);
+}
@@ -65,6 +65,10 @@ class HostService final : public one::host::HostService::Service
     grpc::Status PoolMonitoring(grpc::ServerContext* context,
                                 const one::host::PoolMonitoringRequest* request,
                                 one::ResponseXML* response) override;
+
+    grpc::Status PoolCapacity(grpc::ServerContext* context,
+                              const one::host::PoolCapacityRequest* request,
+                              one::ResponseXML* response) override;
 };
 
 /* ------------------------------------------------------------------------- */
@@ -204,4 +208,19 @@ public:
                          RequestAttributesGRPC& att) override;
 };
 
+/* ------------------------------------------------------------------------- */
+
+class HostPoolCapacityGRPC : public RequestGRPC, public HostPoolCapacityAPI
+{
+public:
+    HostPoolCapacityGRPC() :
+        RequestGRPC("one.hostpool.capacity", "/one.host.HostService/PoolCapacity"),
+        HostPoolCapacityAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
 #endif
@@ -22,6 +22,7 @@
 #include "HookManager.h"
 #include "RaftManager.h"
 #include "ZonePool.h"
+#include "ScopeGuard.h"
 #include "ClientGRPC.h"
 
 #include "shared.pb.h"
@@ -60,6 +61,10 @@ grpc::Status RequestGRPC::execute(grpc::ServerContext* context,
 
     HookManager * hm = nd.get_hm();
 
+    auto start = LatencyHistogram::clock::now();
+
+    one_util::ScopeGuard total_time([&] { observe_phase("total", start); });
+
     bool authenticated = upool->authenticate(att.session,
                                              att.password,
                                              att.uid,
@@ -69,6 +74,8 @@ grpc::Status RequestGRPC::execute(grpc::ServerContext* context,
                                              att.group_ids,
                                              att.umask);
 
+    observe_phase("authentication", start);
+
     if ( _log_method_call )
     {
         logger.log_method_invoked(att, pl, _method_name);
@@ -103,12 +110,16 @@ grpc::Status RequestGRPC::execute(grpc::ServerContext* context,
 
         if (Client::is_grpc(leader_endpoint))
         {
+            auto fwd_start = LatencyHistogram::clock::now();
+
             att.retval = call(leader_endpoint,
                               method_full_name,
                               *request,
                               response,
                               att.resp_msg);
 
+            observe_phase("forward", fwd_start);
+
             att.success = att.retval.ok();
         }
         else
@@ -188,7 +199,11 @@ grpc::Status RequestGRPC::execute(grpc::ServerContext* context,
         else
         {
             // Execute locally
+            auto exec_start = LatencyHistogram::clock::now();
+
             request_execute(request, response, att);
+
+            observe_phase("execution", exec_start);
         }
     }
 
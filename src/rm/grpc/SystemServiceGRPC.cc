@@ -33,6 +33,13 @@ grpc::Status SystemService::Config(grpc::ServerContext* context,
     return SystemConfigGRPC().execute(context, request, response);
 }
 
+grpc::Status SystemService::Metrics(grpc::ServerContext* context,
+                                    const one::system::MetricsRequest* request,
+                                    one::ResponseXML* response)
+{
+    return SystemMetricsGRPC().execute(context, request, response);
+}
+
 grpc::Status SystemService::Sql(grpc::ServerContext* context,
                                 const one::system::SqlRequest* request,
                                 one::ResponseID* response)
@@ -76,6 +83,21 @@ void SystemConfigGRPC::request_execute(const google::protobuf::Message* _request
 
 /* ------------------------------------------------------------------------- */
 
+void SystemMetricsGRPC::request_execute(const google::protobuf::Message* _request,
+                                        google::protobuf::Message*       _response,
+                                        RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::system::MetricsRequest*>(_request);
+
+    std::string metrics_str;
+
+    auto ec = metrics(request->format(), metrics_str, att);
+
+    response(ec, metrics_str, att);
+}
+
+/* ------------------------------------------------------------------------- */
+
 void SystemSqlGRPC::request_execute(const google::protobuf::Message* _request,
                                     google::protobuf::Message*       _response,
                                     RequestAttributesGRPC& att)
@@ -34,6 +34,10 @@ class SystemService final : public one::system::SystemService::Service
                         const one::system::ConfigRequest* request,
                         one::ResponseXML* response) override;
 
+    grpc::Status Metrics(grpc::ServerContext* context,
+                         const one::system::MetricsRequest* request,
+                         one::ResponseXML* response) override;
+
     grpc::Status Sql(grpc::ServerContext* context,
                      const one::system::SqlRequest* request,
                      one::ResponseID* response) override;
@@ -76,6 +80,23 @@ public:
 
 /* ------------------------------------------------------------------------- */
 
+class SystemMetricsGRPC : public RequestGRPC, public SystemMetricsAPI
+{
+public:
+    SystemMetricsGRPC() :
+        RequestGRPC("one.system.metrics", "/one.system.SystemService/Metrics"),
+        SystemMetricsAPI(static_cast<Request&>(*this))
+    {
+        log_method_call(false);
+    }
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+
 class SystemSqlGRPC : public RequestGRPC, public SystemAPI
 {
 public:
@@ -69,6 +69,13 @@ grpc::Status TemplateService::Instantiate(grpc::ServerContext* context,
     return TemplateInstantiateGRPC().execute(context, request, response);
 }
 
+grpc::Status TemplateService::InstantiateBatch(grpc::ServerContext* context,
+                                               const one::tmpl::InstantiateBatchRequest* request,
+                                               one::ResponseXML* response)
+{
+    return TemplateInstantiateBatchGRPC().execute(context, request, response);
+}
+
 grpc::Status TemplateService::Chmod(grpc::ServerContext* context,
                                     const one::tmpl::ChmodRequest* request,
                                     one::ResponseID* response)
@@ -238,6 +245,28 @@ void TemplateInstantiateGRPC::request_execute(const google::protobuf::Message* _
 
 /* ------------------------------------------------------------------------- */
 
+void TemplateInstantiateBatchGRPC::request_execute(const google::protobuf::Message* _request,
+                                                   google::protobuf::Message*       _response,
+                                                   RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::tmpl::InstantiateBatchRequest*>(_request);
+
+    std::vector<int> vids;
+
+    auto ec = instantiate(request->oid(),
+                          request->name(),
+                          request->hold(),
+                          request->extra_template(),
+                          request->persistent(),
+                          request->n_vms(),
+                          vids,
+                          att);
+
+    response(ec, one_util::join(vids, ','), att);
+}
+
+/* ------------------------------------------------------------------------- */
+
 void TemplateChmodGRPC::request_execute(const google::protobuf::Message* _request,
                                         google::protobuf::Message*       _response,
                                         RequestAttributesGRPC& att)
@@ -58,6 +58,10 @@ class TemplateService final : public one::tmpl::TemplateService::Service
                              const one::tmpl::InstantiateRequest* request,
                              one::ResponseID* response) override;
 
+    grpc::Status InstantiateBatch(grpc::ServerContext* context,
+                                  const one::tmpl::InstantiateBatchRequest* request,
+                                  one::ResponseXML* response) override;
+
     grpc::Status Chmod(grpc::ServerContext* context,
                        const one::tmpl::ChmodRequest* request,
                        one::ResponseID* response) override;
@@ -187,6 +191,21 @@ public:
 
 /* ------------------------------------------------------------------------- */
 
+class TemplateInstantiateBatchGRPC : public RequestGRPC, public TemplateAPI
+{
+public:
+    TemplateInstantiateBatchGRPC() :
+        RequestGRPC("one.template.instantiatebatch", "/one.tmpl.TemplateService/InstantiateBatch"),
+        TemplateAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+
 class TemplateChmodGRPC : public RequestGRPC, public TemplateAPI
 {
 public:
@@ -355,6 +355,15 @@ grpc::Status VirtualMachineService::PoolInfoSet(grpc::ServerContext* context,
 
 /* ------------------------------------------------------------------------- */
 
+grpc::Status VirtualMachineService::PoolAction(grpc::ServerContext* context,
+                                               const one::vm::PoolActionRequest* request,
+                                               one::ResponseXML* response)
+{
+    return VirtualMachinePoolActionGRPC().execute(context, request, response);
+}
+
+/* ------------------------------------------------------------------------- */
+
 grpc::Status VirtualMachineService::PoolMonitoring(grpc::ServerContext* context,
                                                    const one::vm::PoolMonitoringRequest* request,
                                                    one::ResponseXML* response)
@@ -373,6 +382,15 @@ grpc::Status VirtualMachineService::PoolAccounting(grpc::ServerContext* context,
 
 /* ------------------------------------------------------------------------- */
 
+grpc::Status VirtualMachineService::PoolAccountingTotals(grpc::ServerContext* context,
+                                                         const one::vm::PoolAccountingTotalsRequest* request,
+                                                         one::ResponseXML* response)
+{
+    return VirtualMachinePoolAccountingTotalsGRPC().execute(context, request, response);
+}
+
+/* ------------------------------------------------------------------------- */
+
 grpc::Status VirtualMachineService::PoolShowback(grpc::ServerContext* context,
                                                  const one::vm::PoolShowbackRequest* request,
                                                  one::ResponseXML* response)
@@ -1238,6 +1256,24 @@ void VirtualMachinePoolInfoSetGRPC::request_execute(const google::protobuf::Mess
 
 /* ------------------------------------------------------------------------- */
 
+void VirtualMachinePoolActionGRPC::request_execute(const google::protobuf::Message* _request,
+                                                   google::protobuf::Message*       _response,
+                                                   RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::vm::PoolActionRequest*>(_request);
+
+    std::string xml;
+
+    auto ec = pool_action(request->action_name(),
+                          request->ids(),
+                          xml,
+                          att);
+
+    response(ec, xml, att);
+}
+
+/* ------------------------------------------------------------------------- */
+
 void VirtualMachinePoolAccountingGRPC::request_execute(const google::protobuf::Message* _request,
                                                        google::protobuf::Message*       _response,
                                                        RequestAttributesGRPC& att)
@@ -1257,6 +1293,26 @@ void VirtualMachinePoolAccountingGRPC::request_execute(const google::protobuf::M
 
 /* ------------------------------------------------------------------------- */
 
+void VirtualMachinePoolAccountingTotalsGRPC::request_execute(const google::protobuf::Message* _request,
+                                                             google::protobuf::Message*       _response,
+                                                             RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::vm::PoolAccountingTotalsRequest*>(_request);
+
+    std::string xml;
+
+    auto ec = accounting_totals(request->filter_flag(),
+                                request->group_by(),
+                                request->start_time(),
+                                request->end_time(),
+                                xml,
+                                att);
+
+    response(ec, xml, att);
+}
+
+/* ------------------------------------------------------------------------- */
+
 void VirtualMachinePoolMonitoringGRPC::request_execute(const google::protobuf::Message* _request,
                                                        google::protobuf::Message*       _response,
                                                        RequestAttributesGRPC& att)
@@ -218,6 +218,10 @@ class VirtualMachineService final : public one::vm::VirtualMachineService::Servi
                              const one::vm::PoolInfoSetRequest* request,
                              one::ResponseXML* response) override;
 
+    grpc::Status PoolAction(grpc::ServerContext* context,
+                            const one::vm::PoolActionRequest* request,
+                            one::ResponseXML* response) override;
+
     grpc::Status PoolMonitoring(grpc::ServerContext* context,
                                 const one::vm::PoolMonitoringRequest* request,
                                 one::ResponseXML* response) override;
@@ -226,6 +230,10 @@ class VirtualMachineService final : public one::vm::VirtualMachineService::Servi
                                 const one::vm::PoolAccountingRequest* request,
                                 one::ResponseXML* response) override;
 
+    grpc::Status PoolAccountingTotals(grpc::ServerContext* context,
+                                      const one::vm::PoolAccountingTotalsRequest* request,
+                                      one::ResponseXML* response) override;
+
     grpc::Status PoolShowback(grpc::ServerContext* context,
                               const one::vm::PoolShowbackRequest* request,
                               one::ResponseXML* response) override;
@@ -944,6 +952,21 @@ public:
 
 /* ------------------------------------------------------------------------- */
 
+class VirtualMachinePoolActionGRPC : public RequestGRPC, public VirtualMachineAPI
+{
+public:
+    VirtualMachinePoolActionGRPC()
+        : RequestGRPC("one.vmpool.action", "/one.vm.VirtualMachineService/PoolAction")
+        , VirtualMachineAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+
 class VirtualMachinePoolMonitoringGRPC : public RequestGRPC, public VirtualMachinePoolAPI
 {
 public:
@@ -974,6 +997,21 @@ public:
 
 /* ------------------------------------------------------------------------- */
 
+class VirtualMachinePoolAccountingTotalsGRPC : public RequestGRPC, public VirtualMachinePoolAPI
+{
+public:
+    VirtualMachinePoolAccountingTotalsGRPC()
+        : RequestGRPC("one.vmpool.accountingtotals", "/one.vm.VirtualMachineService/PoolAccountingTotals")
+        , VirtualMachinePoolAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+
 class VirtualMachinePoolShowbackCalculateGRPC : public RequestGRPC, public VirtualMachinePoolShowbackCalculateAPI
 {
 public:
@@ -105,6 +105,13 @@ grpc::Status ZoneService::ReplicateFedLog(grpc::ServerContext* context,
     return ZoneReplicateFedLogGRPC().execute(context, request, response);
 }
 
+grpc::Status ZoneService::ReplicateFedLogBatch(grpc::ServerContext* context,
+                                               const one::zone::ReplicateFedLogBatchRequest* request,
+                                               one::zone::ResponseReplicateFedLog* response)
+{
+    return ZoneReplicateFedLogBatchGRPC().execute(context, request, response);
+}
+
 grpc::Status ZoneService::UpdateDB(grpc::ServerContext* context,
                                    const one::zone::UpdateDBRequest* request,
                                    one::ResponseID* response)
@@ -369,6 +376,33 @@ void ZoneReplicateFedLogGRPC::request_execute(const google::protobuf::Message* _
 
 /* ------------------------------------------------------------------------- */
 
+void ZoneReplicateFedLogBatchGRPC::request_execute(const google::protobuf::Message* _request,
+                                                  google::protobuf::Message*       _response,
+                                                  RequestAttributesGRPC& att)
+{
+    auto request = static_cast<const one::zone::ReplicateFedLogBatchRequest*>(_request);
+
+    std::vector<uint64_t> indexes(request->index().begin(), request->index().end());
+    std::vector<std::string> sqls(request->sql().begin(), request->sql().end());
+
+    auto ec = replicate_fed_log_batch(request->prev(), indexes, sqls, att);
+
+    // Special handling, even in case of failure we return grpc::Status::OK
+    // The failure is stored in the response->success
+    if (HookAPI::supported_call(_method_name))
+    {
+        make_xml_response(ec, att.resp_id, att);
+    }
+
+    auto response = static_cast<one::zone::ResponseReplicateFedLog*>(att.response);
+
+    att.retval = grpc::Status::OK;
+    response->set_success(ec == Request::SUCCESS);
+    response->set_index(att.replication_idx);
+}
+
+/* ------------------------------------------------------------------------- */
+
 void ZoneUpdateDBGRPC::request_execute(const google::protobuf::Message* _request,
                                      google::protobuf::Message*       _response,
                                      RequestAttributesGRPC& att)
@@ -75,6 +75,10 @@ class ZoneService final : public one::zone::ZoneService::Service
                                  const one::zone::ReplicateFedLogRequest* request,
                                  one::zone::ResponseReplicateFedLog* response) override;
 
+    grpc::Status ReplicateFedLogBatch(grpc::ServerContext* context,
+                                      const one::zone::ReplicateFedLogBatchRequest* request,
+                                      one::zone::ResponseReplicateFedLog* response) override;
+
     grpc::Status UpdateDB(grpc::ServerContext* context,
                           const one::zone::UpdateDBRequest* request,
                           one::ResponseID* response) override;
@@ -279,6 +283,21 @@ public:
 
 /* ------------------------------------------------------------------------- */
 
+class ZoneReplicateFedLogBatchGRPC : public RequestGRPC, public ZoneReplicateFedLogAPI
+{
+public:
+    ZoneReplicateFedLogBatchGRPC() :
+        RequestGRPC("one.zone.fedreplicatebatch", "/one.zone.ZoneService/ReplicateFedLogBatch"),
+        ZoneReplicateFedLogAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(const google::protobuf::Message* _request,
+                         google::protobuf::Message*       _response,
+                         RequestAttributesGRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+
 class ZoneUpdateDBGRPC : public RequestGRPC, public ZoneAPI
 {
 public:
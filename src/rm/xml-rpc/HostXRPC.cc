@@ -160,3 +160,39 @@ void HostPoolMonitoringXRPC::request_execute(
 
     response(ec, xml, att);
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void HostPoolCapacityXRPC::request_execute(
+        xmlrpc_c::paramList const&  paramList,
+        RequestAttributesXRPC&      att)
+{
+    string xml;
+
+    // Versions are 64 bits, accept them as i8 or int
+    auto uint64_param = [&paramList](unsigned int i) -> uint64_t
+    {
+        if ( paramList.size() <= i )
+        {
+            return 0;
+        }
+
+        long long value;
+
+        if ( paramList[i].type() == xmlrpc_c::value::TYPE_I8 )
+        {
+            value = paramList.getI8(i);
+        }
+        else
+        {
+            value = paramList.getInt(i);
+        }
+
+        return value > 0 ? value : 0;
+    };
+
+    auto ec = capacity(uint64_param(2), uint64_param(1), xml, att);
+
+    response(ec, xml, att);
+}
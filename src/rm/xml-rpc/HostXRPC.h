@@ -173,4 +173,21 @@ public:
                          RequestAttributesXRPC& att) override;
 };
 
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
+class HostPoolCapacityXRPC : public RequestXRPC, public HostPoolCapacityAPI
+{
+public:
+    HostPoolCapacityXRPC()
+        : RequestXRPC("one.hostpool.capacity",
+                      "Returns the host capacity records changed since a version",
+                      "A:sii")
+        , HostPoolCapacityAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(xmlrpc_c::paramList const& _paramList,
+                         RequestAttributesXRPC& att) override;
+};
+
 #endif
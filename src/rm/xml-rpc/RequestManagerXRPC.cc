@@ -341,6 +341,7 @@ void RequestManagerXRPC::register_xml_methods()
     xmlrpc_c::methodPtr host_monitoring(new HostMonitoringXRPC());
     xmlrpc_c::methodPtr hostpool_info(new HostPoolInfoXRPC());
     xmlrpc_c::methodPtr host_pool_monitoring(new HostPoolMonitoringXRPC());
+    xmlrpc_c::methodPtr host_pool_capacity(new HostPoolCapacityXRPC());
 
     RequestManagerRegistry.addMethod("one.host.allocate", host_allocate);
     RequestManagerRegistry.addMethod("one.host.delete", host_delete);
@@ -352,6 +353,7 @@ void RequestManagerXRPC::register_xml_methods()
 
     RequestManagerRegistry.addMethod("one.hostpool.info", hostpool_info);
     RequestManagerRegistry.addMethod("one.hostpool.monitoring", host_pool_monitoring);
+    RequestManagerRegistry.addMethod("one.hostpool.capacity", host_pool_capacity);
 
     // Cluster related methods
     xmlrpc_c::methodPtr cluster_allocate(new ClusterAllocateXRPC());
@@ -401,6 +403,7 @@ void RequestManagerXRPC::register_xml_methods()
     xmlrpc_c::methodPtr template_unlock(new TemplateUnlockXRPC());
     xmlrpc_c::methodPtr template_clone(new TemplateCloneXRPC());
     xmlrpc_c::methodPtr template_instantiate(new TemplateInstantiateXRPC());
+    xmlrpc_c::methodPtr template_instantiate_batch(new TemplateInstantiateBatchXRPC());
 
     xmlrpc_c::methodPtr template_pool_info(new TemplatePoolInfoXRPC());
 
@@ -415,6 +418,7 @@ void RequestManagerXRPC::register_xml_methods()
     RequestManagerRegistry.addMethod("one.template.unlock", template_unlock);
     RequestManagerRegistry.addMethod("one.template.clone", template_clone);
     RequestManagerRegistry.addMethod("one.template.instantiate", template_instantiate);
+    RequestManagerRegistry.addMethod("one.template.instantiatebatch", template_instantiate_batch);
 
     RequestManagerRegistry.addMethod("one.templatepool.info", template_pool_info);
 
@@ -496,7 +500,9 @@ void RequestManagerXRPC::register_xml_methods()
     xmlrpc_c::methodPtr vm_pool_info(new VirtualMachinePoolInfoXRPC());
     xmlrpc_c::methodPtr vm_pool_info_extended(new VirtualMachinePoolInfoExtendedXRPC());
     xmlrpc_c::methodPtr vm_pool_info_set(new VirtualMachinePoolInfoSetXRPC());
+    xmlrpc_c::methodPtr vm_pool_action(new VirtualMachinePoolActionXRPC());
     xmlrpc_c::methodPtr vm_pool_acct(new VirtualMachinePoolAccountingXRPC());
+    xmlrpc_c::methodPtr vm_pool_acct_totals(new VirtualMachinePoolAccountingTotalsXRPC());
     xmlrpc_c::methodPtr vm_pool_monitoring(new VirtualMachinePoolMonitoringXRPC());
     xmlrpc_c::methodPtr vm_pool_showback(new VirtualMachinePoolShowbackListXRPC());
     xmlrpc_c::methodPtr vm_pool_calculate_showback(new VirtualMachinePoolShowbackCalculateXRPC());
@@ -549,7 +555,9 @@ void RequestManagerXRPC::register_xml_methods()
     RequestManagerRegistry.addMethod("one.vmpool.info", vm_pool_info);
     RequestManagerRegistry.addMethod("one.vmpool.infoextended", vm_pool_info_extended);
     RequestManagerRegistry.addMethod("one.vmpool.infoset", vm_pool_info_set);
+    RequestManagerRegistry.addMethod("one.vmpool.action", vm_pool_action);
     RequestManagerRegistry.addMethod("one.vmpool.accounting", vm_pool_acct);
+    RequestManagerRegistry.addMethod("one.vmpool.accountingtotals", vm_pool_acct_totals);
     RequestManagerRegistry.addMethod("one.vmpool.monitoring", vm_pool_monitoring);
     RequestManagerRegistry.addMethod("one.vmpool.showback", vm_pool_showback);
     RequestManagerRegistry.addMethod("one.vmpool.calculateshowback", vm_pool_calculate_showback);
@@ -857,6 +865,7 @@ void RequestManagerXRPC::register_xml_methods()
     xmlrpc_c::methodPtr zone_voterequest(new ZoneVoteXRPC());
     xmlrpc_c::methodPtr zone_raftstatus(new ZoneRaftStatusXRPC());
     xmlrpc_c::methodPtr zone_fedreplicatelog(new ZoneReplicateFedLogXRPC());
+    xmlrpc_c::methodPtr zone_fedreplicatebatch(new ZoneReplicateFedLogBatchXRPC());
 
     xmlrpc_c::methodPtr zone_info(new ZoneInfoXRPC());
     xmlrpc_c::methodPtr zonepool_info(new ZonePoolInfoXRPC());
@@ -869,6 +878,7 @@ void RequestManagerXRPC::register_xml_methods()
     RequestManagerRegistry.addMethod("one.zone.enable",   zone_enable);
     RequestManagerRegistry.addMethod("one.zone.replicate", zone_replicatelog);
     RequestManagerRegistry.addMethod("one.zone.fedreplicate", zone_fedreplicatelog);
+    RequestManagerRegistry.addMethod("one.zone.fedreplicatebatch", zone_fedreplicatebatch);
     RequestManagerRegistry.addMethod("one.zone.voterequest", zone_voterequest);
     RequestManagerRegistry.addMethod("one.zone.raftstatus", zone_raftstatus);
 
@@ -1260,11 +1270,13 @@ void RequestManagerXRPC::register_xml_methods()
     // System related methods
     xmlrpc_c::methodPtr system_version(new SystemVersionXRPC());
     xmlrpc_c::methodPtr system_config(new SystemConfigXRPC());
+    xmlrpc_c::methodPtr system_metrics(new SystemMetricsXRPC());
     xmlrpc_c::methodPtr system_sql(new SystemSqlXRPC());
     xmlrpc_c::methodPtr system_sqlquery(new SystemSqlQueryXRPC());
 
     RequestManagerRegistry.addMethod("one.system.version", system_version);
     RequestManagerRegistry.addMethod("one.system.config", system_config);
+    RequestManagerRegistry.addMethod("one.system.metrics", system_metrics);
     RequestManagerRegistry.addMethod("one.system.sql", system_sql);
     RequestManagerRegistry.addMethod("one.system.sqlquery", system_sqlquery);
 };
@@ -23,6 +23,7 @@
 #include "HookManager.h"
 #include "RaftManager.h"
 #include "ZonePool.h"
+#include "ScopeGuard.h"
 
 #include <xmlrpc-c/abyss.h>
 
@@ -55,6 +56,10 @@ void RequestXRPC::execute(
 
     HookManager * hm = nd.get_hm();
 
+    auto start = LatencyHistogram::clock::now();
+
+    one_util::ScopeGuard total_time([&] { observe_phase("total", start); });
+
     bool authenticated = upool->authenticate(att.session,
                                              att.password,
                                              att.uid,
@@ -64,6 +69,8 @@ void RequestXRPC::execute(
                                              att.group_ids,
                                              att.umask);
 
+    observe_phase("authentication", start);
+
     if ( _log_method_call )
     {
         logger.log_method_invoked(att, pl, _method_name);
@@ -98,6 +105,8 @@ void RequestXRPC::execute(
 
         int rc;
 
+        auto fwd_start = LatencyHistogram::clock::now();
+
         if (Client::is_grpc(leader_endpoint))
         {
             rc = -1;
@@ -114,6 +123,8 @@ void RequestXRPC::execute(
                                   att.resp_msg);
         }
 
+        observe_phase("forward", fwd_start);
+
         if ( rc != 0 )
         {
             Request::failure_response(INTERNAL, att);
@@ -149,7 +160,11 @@ void RequestXRPC::execute(
             return;
         }
 
+        auto exec_start = LatencyHistogram::clock::now();
+
         request_execute(_paramList, att);
+
+        observe_phase("execution", exec_start);
     }
 
     //--------------------------------------------------------------------------
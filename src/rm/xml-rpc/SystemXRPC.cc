@@ -34,6 +34,21 @@ void SystemVersionXRPC::request_execute(xmlrpc_c::paramList const& paramList,
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+void SystemMetricsXRPC::request_execute(xmlrpc_c::paramList const& paramList,
+                                        RequestAttributesXRPC& att)
+{
+    string metrics_str;
+
+    auto ec = metrics(paramList.size() > 1 ? paramList.getInt(1) : 0, // format
+                      metrics_str,
+                      att);
+
+    response(ec, metrics_str, att);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 void SystemConfigXRPC::request_execute(xmlrpc_c::paramList const& paramList,
                                        RequestAttributesXRPC& att)
 {
@@ -40,6 +40,25 @@ public:
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
+class SystemMetricsXRPC : public RequestXRPC, public SystemMetricsAPI
+{
+public:
+    SystemMetricsXRPC() :
+        RequestXRPC("one.system.metrics",
+                    "Returns the internal metrics of the OpenNebula server",
+                    "A:si"),
+        SystemMetricsAPI(static_cast<Request&>(*this))
+    {
+        log_method_call(false);
+    }
+
+    void request_execute(xmlrpc_c::paramList const& _paramList,
+                         RequestAttributesXRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
 class SystemConfigXRPC : public RequestXRPC, public SystemConfigAPI
 {
 public:
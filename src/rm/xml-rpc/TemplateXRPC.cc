@@ -139,6 +139,26 @@ void TemplateInstantiateXRPC::request_execute(xmlrpc_c::paramList const& paramLi
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+void TemplateInstantiateBatchXRPC::request_execute(xmlrpc_c::paramList const& paramList,
+                                                   RequestAttributesXRPC&     att)
+{
+    vector<int> vids;
+
+    auto ec = instantiate(paramList.getInt(1),     // id
+                          paramList.getString(3),  // name
+                          paramList.size() > 4 ? paramList.getBoolean(4) : false, // hold
+                          paramList.size() > 5 ? paramList.getString(5)  : "",    // extra template
+                          paramList.size() > 6 ? paramList.getBoolean(6) : false, // persistent
+                          paramList.getInt(2),     // number of VMs
+                          vids,
+                          att);
+
+    response(ec, one_util::join(vids, ','), att);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 void TemplateChmodXRPC::request_execute(xmlrpc_c::paramList const& paramList,
                                         RequestAttributesXRPC&     att)
 {
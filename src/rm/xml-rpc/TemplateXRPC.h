@@ -143,6 +143,23 @@ public:
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
+class TemplateInstantiateBatchXRPC : public RequestXRPC, public TemplateAPI
+{
+public:
+    TemplateInstantiateBatchXRPC() :
+        RequestXRPC("one.template.instantiatebatch",
+                    "Instantiates a set of Virtual Machines using a template",
+                    "A:siisbsb"),
+        TemplateAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(xmlrpc_c::paramList const& _paramList,
+                         RequestAttributesXRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
 class TemplateChmodXRPC: public RequestXRPC, public TemplateAPI
 {
 public:
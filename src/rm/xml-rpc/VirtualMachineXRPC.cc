@@ -731,6 +731,21 @@ void VirtualMachinePoolInfoSetXRPC::request_execute(xmlrpc_c::paramList const& p
 
 /* -------------------------------------------------------------------------- */
 
+void VirtualMachinePoolActionXRPC::request_execute(xmlrpc_c::paramList const& paramList,
+                                                   RequestAttributesXRPC&     att)
+{
+    string xml;
+
+    auto ec = pool_action(paramList.getString(1), // action
+                          paramList.getString(2), // ids
+                          xml,
+                          att);
+
+    response(ec, xml, att);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void VirtualMachinePoolMonitoringXRPC::request_execute(xmlrpc_c::paramList const& paramList,
                                                        RequestAttributesXRPC&     att)
 {
@@ -762,6 +777,23 @@ void VirtualMachinePoolAccountingXRPC::request_execute(xmlrpc_c::paramList const
 
 /* -------------------------------------------------------------------------- */
 
+void VirtualMachinePoolAccountingTotalsXRPC::request_execute(xmlrpc_c::paramList const& paramList,
+                                                             RequestAttributesXRPC&     att)
+{
+    string xml;
+
+    auto ec = accounting_totals(paramList.getInt(1), // filter flag
+                                paramList.getInt(2), // group by
+                                paramList.getInt(3), // time start
+                                paramList.getInt(4), // time end
+                                xml,
+                                att);
+
+    response(ec, xml, att);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void VirtualMachinePoolShowbackCalculateXRPC::request_execute(xmlrpc_c::paramList const& paramList,
                                                               RequestAttributesXRPC&     att)
 {
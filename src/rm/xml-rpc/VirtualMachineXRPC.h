@@ -821,6 +821,23 @@ public:
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
+class VirtualMachinePoolActionXRPC : public RequestXRPC, public VirtualMachineAPI
+{
+public:
+    VirtualMachinePoolActionXRPC()
+        : RequestXRPC("one.vmpool.action",
+                      "Performs an action on a set of Virtual Machines",
+                      "A:sss")
+        , VirtualMachineAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(xmlrpc_c::paramList const& _paramList,
+                         RequestAttributesXRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
 class VirtualMachinePoolMonitoringXRPC : public RequestXRPC, public VirtualMachinePoolAPI
 {
 public:
@@ -855,6 +872,23 @@ public:
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
+class VirtualMachinePoolAccountingTotalsXRPC : public RequestXRPC, public VirtualMachinePoolAPI
+{
+public:
+    VirtualMachinePoolAccountingTotalsXRPC()
+        : RequestXRPC("one.vmpool.accountingtotals",
+                      "Returns the Virtual Machine accounting totals",
+                      "A:siiii")
+        , VirtualMachinePoolAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(xmlrpc_c::paramList const& _paramList,
+                         RequestAttributesXRPC& att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
 class VirtualMachinePoolShowbackCalculateXRPC : public RequestXRPC, public VirtualMachinePoolShowbackCalculateAPI
 {
 public:
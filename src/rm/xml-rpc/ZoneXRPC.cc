@@ -209,6 +209,37 @@ void ZoneReplicateFedLogXRPC::request_execute(xmlrpc_c::paramList const& paramLi
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+void ZoneReplicateFedLogBatchXRPC::request_execute(xmlrpc_c::paramList const& paramList,
+                                                   RequestAttributesXRPC& att)
+{
+    std::vector<uint64_t>    indexes;
+    std::vector<std::string> sqls;
+
+    auto xidx = xmlrpc_c::value_array(paramList.getArray(2)).vectorValueValue();
+
+    for (const auto& val : xidx)
+    {
+        indexes.push_back(xmlrpc_c::value_i8(val));
+    }
+
+    auto xsql = xmlrpc_c::value_array(paramList.getArray(3)).vectorValueValue();
+
+    for (const auto& val : xsql)
+    {
+        sqls.push_back(xmlrpc_c::value_string(val));
+    }
+
+    auto ec = replicate_fed_log_batch(paramList.getI8(1),  // prev
+                                      indexes,
+                                      sqls,
+                                      att);
+
+    response(ec, att.replication_idx, att);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 void ZoneUpdateDBXRPC::request_execute(xmlrpc_c::paramList const& paramList,
                                        RequestAttributesXRPC& att)
 {
@@ -229,6 +229,23 @@ public:
 /* ------------------------------------------------------------------------- */
 /* ------------------------------------------------------------------------- */
 
+class ZoneReplicateFedLogBatchXRPC : public RequestXRPC, public ZoneReplicateFedLogAPI
+{
+public:
+    ZoneReplicateFedLogBatchXRPC():
+        RequestXRPC("one.zone.fedreplicatebatch",
+                    "Replicate a batch of fed log records",
+                    "A:siAA"),
+        ZoneReplicateFedLogAPI(static_cast<Request&>(*this))
+    {}
+
+    void request_execute(xmlrpc_c::paramList const&  _paramList,
+                         RequestAttributesXRPC&      att) override;
+};
+
+/* ------------------------------------------------------------------------- */
+/* ------------------------------------------------------------------------- */
+
 class ZoneUpdateDBXRPC : public RequestXRPC, public ZoneAPI
 {
 public:
@@ -26,6 +26,8 @@
 #include "Request.h"
 #include "RequestAttributes.h"
 
+#include <algorithm>
+
 using namespace std;
 
 /* -------------------------------------------------------------------------- */
@@ -33,10 +35,17 @@ using namespace std;
 
 ScheduledActionManager::ScheduledActionManager(time_t timer,
                                                int max_backups,
-                                               int max_backups_host)
-    : timer_thread(timer, [this]() {timer_action();})
+                                               int max_backups_host,
+                                               int max_backups_ds,
+                                               long long max_backups_ds_size,
+                                               long long backup_ds_rate)
+    : timer_thread(1, [this]() {timer_action();})
+, _timer_period(timer)
 , _max_backups(max_backups)
 , _max_backups_host(max_backups_host)
+, _max_backups_ds(max_backups_ds)
+, _max_backups_ds_size(max_backups_ds_size)
+, _backup_ds_rate(backup_ds_rate)
 {
     NebulaLog::info("SCH", "Staring Scheduled Action Manager...");
 
@@ -64,22 +73,57 @@ void ScheduledActionManager::timer_action()
 
     if (!raftm || (!raftm->is_leader() && !raftm->is_solo()))
     {
+        // Followers update the table through log replication, reload the
+        // index when this server becomes the leader
+        sa_pool->invalidate_index();
+
+        last_backup_scan = 0;
+
+        failed_actions.clear();
+
         return;
     }
 
+    time_t the_time = time(0);
+
+    bool backup_scan = the_time - last_backup_scan >= _timer_period;
+
     scheduled_vm_actions();
 
-    update_backup_counters();
+    set<int> due_backups;
 
-    run_vm_backups();
+    for (const auto& backup : vm_backups)
+    {
+        due_backups.insert(backup.first);
 
-    scheduled_backup_jobs();
+        backup_scan = backup_scan || seen_backups.count(backup.first) == 0;
+    }
 
-    backup_jobs();
+    seen_backups.swap(due_backups);
+
+    if (scheduled_backup_jobs())
+    {
+        backup_scan = true;
+    }
+
+    if (backup_scan)
+    {
+        last_backup_scan = the_time;
+
+        update_backup_counters();
+
+        run_vm_backups();
+
+        backup_jobs();
+
+        log_backup_prediction();
+    }
 
     vm_backups.clear();
 
     host_backups.clear();
+
+    ds_backups.clear();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -92,6 +136,10 @@ void ScheduledActionManager::scheduled_vm_actions()
 
     set<int> processed_vms;
 
+    map<int, time_t> failed;
+
+    time_t the_time = time(0);
+
     for (const auto& action : actions_to_launch)
     {
         auto vm_id = action.second;
@@ -103,6 +151,18 @@ void ScheduledActionManager::scheduled_vm_actions()
 
         processed_vms.insert(vm_id);
 
+        auto it = failed_actions.find(action.first);
+
+        if (it != failed_actions.end())
+        {
+            failed.insert(*it);
+
+            if (it->second > the_time)
+            {
+                continue;
+            }
+        }
+
         auto sa = sa_pool->get_ro(action.first);
 
         if (!sa)
@@ -124,8 +184,61 @@ void ScheduledActionManager::scheduled_vm_actions()
 
         sa.reset();
 
-        run_scheduled_action_vm(vm_id, action.first, aname);
+        if (run_scheduled_action_vm(vm_id, action.first, aname) == 0)
+        {
+            failed.erase(action.first);
+        }
+        else
+        {
+            failed[action.first] = the_time + _timer_period;
+        }
     }
+
+    // Keep only the failed actions that are still due
+    failed_actions.swap(failed);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+/**
+ *  Estimated size (MB) of the next backup of a VM. Incremental backups use the
+ *  size of the last increment, full backups the size of the disks.
+ */
+static long long backup_estimate(VirtualMachine * vm)
+{
+    auto& backups = vm->backups();
+
+    long long size = 0;
+
+    if (backups.mode() == Backups::INCREMENT &&
+        backups.incremental_backup_id() != -1 &&
+        backups.last_increment_id() != -1 &&
+        one_util::str_cast(backups.last_backup_size(), size) && size > 0)
+    {
+        return size;
+    }
+
+    Template ds_quota;
+
+    return vm->backup_size(ds_quota);
+}
+
+/**
+ *  Target datastore of a scheduled backup, ARGS = "datastore-id, reset"
+ */
+static int backup_ds_id(ScheduledActionPool * sa_pool, int sa_id)
+{
+    int ds_id = -1;
+
+    if (auto sa = sa_pool->get_ro(sa_id))
+    {
+        istringstream is(sa->args());
+
+        is >> ds_id;
+    }
+
+    return ds_id;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -138,8 +251,6 @@ void ScheduledActionManager::update_backup_counters()
 
     vm_pool->get_backup(backups);
 
-    active_backups = backups.size();
-
     for (auto vm_id : backups)
     {
         auto vm = vm_pool->get_ro(vm_id);
@@ -149,17 +260,94 @@ void ScheduledActionManager::update_backup_counters()
             continue;
         }
 
-        auto hid = vm->get_hid();
-        auto it  = host_backups.find(hid);
+        add_backup(vm->get_hid(), vm->backups().last_datastore_id(),
+                   backup_estimate(vm.get()));
+    }
 
-        if ( it == host_backups.end() )
-        {
-            host_backups.insert(std::pair<int, int>(hid, 1));
-        }
-        else
+    active_backups = backups.size();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool ScheduledActionManager::check_backup_limits(int hid, int ds_id,
+                                                 long long size, string& error)
+{
+    ostringstream oss;
+
+    auto& dsb = ds_backups[ds_id];
+
+    if (_max_backups_host != 0 && host_backups[hid] >= _max_backups_host)
+    {
+        oss << "Reached max number of backups (" << _max_backups_host
+            << ") for host " << hid;
+    }
+    else if (_max_backups_ds != 0 && dsb.active >= _max_backups_ds)
+    {
+        oss << "Reached max number of backups (" << _max_backups_ds
+            << ") for datastore " << ds_id;
+    }
+    else if (_max_backups_ds_size != 0 && dsb.active > 0 &&
+             dsb.active_size + size > _max_backups_ds_size)
+    {
+        oss << "Reached max size of backups (" << _max_backups_ds_size
+            << " MB) for datastore " << ds_id;
+    }
+    else
+    {
+        return true;
+    }
+
+    error = oss.str();
+
+    dsb.pending      += 1;
+    dsb.pending_size += size;
+
+    return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ScheduledActionManager::add_backup(int hid, int ds_id, long long size)
+{
+    auto& dsb = ds_backups[ds_id];
+
+    dsb.active      += 1;
+    dsb.active_size += size;
+
+    ++host_backups[hid];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ScheduledActionManager::log_backup_prediction()
+{
+    if (_backup_ds_rate <= 0)
+    {
+        return;
+    }
+
+    time_t the_time = time(0);
+
+    for (const auto& it : ds_backups)
+    {
+        const auto& dsb = it.second;
+
+        if (dsb.active == 0 && dsb.pending == 0)
         {
-            ++it->second;
+            continue;
         }
+
+        long long secs = (dsb.active_size + dsb.pending_size) / _backup_ds_rate;
+
+        ostringstream oss;
+
+        oss << "Backup datastore " << it.first << ": " << dsb.active
+            << " active (" << dsb.active_size << " MB), " << dsb.pending
+            << " waiting (" << dsb.pending_size << " MB). Predicted completion"
+            << " in " << secs << "s, at " << one_util::log_time(the_time + secs);
+
+        NebulaLog::info("SCH", oss.str());
     }
 }
 
@@ -176,7 +364,7 @@ void ScheduledActionManager::run_vm_backups()
         /* ------------------------------------------------------------------ */
         /* Backup jobs consistency checks:                                    */
         /*  - Active backups vs max_backups                                   */
-        /*  - Active backups in host per max_backups_host                     */
+        /*  - Active backups in host and datastore (max_backups_host/ds)      */
         /*  - VM still exists                                                 */
         /* ------------------------------------------------------------------ */
         if (_max_backups != 0 && active_backups >= _max_backups)
@@ -228,17 +416,20 @@ void ScheduledActionManager::run_vm_backups()
             continue;
         }
 
-        // Check max backups host
-        int hid = vm->get_hid();
+        // Check max backups of the host and target datastore, other VMs may
+        // use a different host or datastore
+        int hid   = vm->get_hid();
+        int ds_id = backup_ds_id(sa_pool, sa_id);
 
-        if (_max_backups_host != 0 && host_backups[hid] >= _max_backups_host)
-        {
-            std::ostringstream oss;
-            oss << "Reached max number of host backups (" << _max_backups_host
-                << ") for host " << vm->get_hid();
+        long long size = backup_estimate(vm.get());
 
-            NebulaLog::debug("SCH", oss.str());
-            break;
+        string error;
+
+        if (!check_backup_limits(hid, ds_id, size, error))
+        {
+            NebulaLog::debug("SCH", "Scheduled backup for VM " +
+                             to_string(vm_id) + " waiting: " + error);
+            continue;
         }
 
         vm.reset();
@@ -249,15 +440,18 @@ void ScheduledActionManager::run_vm_backups()
         /* Update backup counters                                             */
         /* ------------------------------------------------------------------ */
         ++active_backups;
-        ++host_backups[hid];
+
+        add_backup(hid, ds_id, size);
     }
 }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void ScheduledActionManager::scheduled_backup_jobs()
+bool ScheduledActionManager::scheduled_backup_jobs()
 {
+    bool executed = false;
+
     // Get IDs of Backup Jobs with due Scheduled Actions from DB
     auto actions_to_launch = sa_pool->get_is_due_actions(PoolObjectSQL::BACKUPJOB);
 
@@ -294,6 +488,8 @@ void ScheduledActionManager::scheduled_backup_jobs()
 
             sa->next_action();
 
+            executed = true;
+
             oss << "Success.";
 
             NebulaLog::info("SCH", oss.str());
@@ -314,6 +510,8 @@ void ScheduledActionManager::scheduled_backup_jobs()
         sa_pool->update(sa.get());
         bj_pool->update(bj.get());
     }
+
+    return executed;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -342,6 +540,50 @@ void ScheduledActionManager::backup_jobs()
         auto ds_id = bj->ds_id();
         auto reset = bj->reset();
 
+        // Backup size estimates, only loaded to sort parallel jobs. Other
+        // VMs get their estimate when checked against the limits
+        map<int, long long> sizes;
+
+        auto dsb = ds_backups.find(ds_id);
+
+        bool ds_full = _max_backups_ds != 0 && dsb != ds_backups.end() &&
+                       dsb->second.active >= _max_backups_ds;
+
+        bool full = (_max_backups != 0 && active_backups >= _max_backups);
+
+        // Start larger VMs first in parallel jobs, so the smaller ones fill
+        // the free slots at the end of the backup window
+        if (mode == BackupJob::PARALLEL && !full && !ds_full && outdated.size() > 1)
+        {
+            for (auto vm_id : vms)
+            {
+                if (!outdated.count(vm_id))
+                {
+                    continue;
+                }
+
+                long long size = 0;
+
+                if (auto vm = vm_pool->get_ro(vm_id))
+                {
+                    size = backup_estimate(vm.get());
+                }
+
+                sizes.emplace(vm_id, size);
+            }
+
+            stable_sort(vms.begin(), vms.end(), [&sizes](int a, int b)
+            {
+                auto it_a = sizes.find(a);
+                auto it_b = sizes.find(b);
+
+                long long size_a = it_a != sizes.end() ? it_a->second : 0;
+                long long size_b = it_b != sizes.end() ? it_b->second : 0;
+
+                return size_a > size_b;
+            });
+        }
+
         for (auto vm_id : vms)
         {
             if (!outdated.count(vm_id))
@@ -353,7 +595,7 @@ void ScheduledActionManager::backup_jobs()
             /* Backup jobs consistency checks:                                */
             /*  - Active backups vs SEQUENTIAL                                */
             /*  - Active backups vs max_backups                               */
-            /*  - Active backups in host per max_backups_host                 */
+            /*  - Active backups in host and datastore (max_backups_host/ds)  */
             /*  - VM is not in DONE                                           */
             /*  - VM still exists                                             */
             /* -------------------------------------------------------------- */
@@ -415,15 +657,25 @@ void ScheduledActionManager::backup_jobs()
 
             int hid = vm->get_hid();
 
-            if (_max_backups_host != 0 && host_backups[hid] >= _max_backups_host)
+            auto it_size = sizes.find(vm_id);
+
+            long long size = it_size != sizes.end() ? it_size->second
+                                                    : backup_estimate(vm.get());
+
+            string limit_error;
+
+            if (!check_backup_limits(hid, ds_id, size, limit_error))
             {
-                std::ostringstream oss;
+                NebulaLog::debug("SCH", "Backup Job " + to_string(bj_id) +
+                                 ": VM " + to_string(vm_id) + " waiting: " +
+                                 limit_error);
 
-                oss << "Reached max number of backups (" << _max_backups_host
-                    << ") for host " << hid;
-                NebulaLog::debug("SCH", oss.str());
+                if (mode == BackupJob::SEQUENTIAL)
+                {
+                    break;
+                }
 
-                break;
+                continue;
             }
 
             /* -------------------------------------------------------------- */
@@ -498,7 +750,8 @@ void ScheduledActionManager::backup_jobs()
             /* Update backup counters                                         */
             /* -------------------------------------------------------------- */
             ++active_backups;
-            ++host_backups[hid];
+
+            add_backup(hid, ds_id, size);
         }
 
         bj_pool->update(bj.get());
@@ -508,7 +761,7 @@ void ScheduledActionManager::backup_jobs()
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void ScheduledActionManager::run_scheduled_action_vm(int vm_id, int sa_id, const std::string& aname)
+int ScheduledActionManager::run_scheduled_action_vm(int vm_id, int sa_id, const std::string& aname)
 {
     std::ostringstream oss;
 
@@ -522,7 +775,7 @@ void ScheduledActionManager::run_scheduled_action_vm(int vm_id, int sa_id, const
 
     if ( !sa )
     {
-        return;
+        return rc;
     }
 
     if (rc == 0)
@@ -549,6 +802,8 @@ void ScheduledActionManager::run_scheduled_action_vm(int vm_id, int sa_id, const
     sa_pool->update(sa.get());
 
     NebulaLog::info("SCH", oss.str());
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -33,7 +33,48 @@ int ScheduledActionPool::allocate(PoolObjectSQL::ObjectType type,
         return -1;
     }
 
-    return PoolSQL::allocate(sched, error_str);
+    int rc = PoolSQL::allocate(sched, error_str);
+
+    if ( rc >= 0 )
+    {
+        index_set(rc, type, parent_id, sched._time, sched._done);
+    }
+
+    return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int ScheduledActionPool::update(PoolObjectSQL * objsql)
+{
+    auto sa = static_cast<ScheduledAction *>(objsql);
+
+    int rc = PoolSQL::update(objsql);
+
+    if ( rc == 0 )
+    {
+        index_set(sa->get_oid(), sa->_type, sa->_parent_id, sa->_time, sa->_done);
+    }
+
+    return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int ScheduledActionPool::drop(PoolObjectSQL * objsql, std::string& error_msg)
+{
+    int oid = objsql->get_oid();
+
+    int rc = PoolSQL::drop(objsql, error_msg);
+
+    if ( rc == 0 )
+    {
+        index_remove(oid);
+    }
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -79,65 +120,156 @@ int ScheduledActionPool::dump(const std::set<int> &actions, std::string& oss)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-template<typename T1, typename T2>
-class vector_pair_cb : public Callbackable
+std::vector<std::pair<int, int>> ScheduledActionPool::get_is_due_actions(PoolObjectSQL::ObjectType ot)
+{
+    std::vector<std::pair<int, int>> actions;
+
+    time_t actual_time = time(0);
+
+    lock_guard<mutex> lock(index_mutex);
+
+    if (!index_valid)
+    {
+        load_index();
+    }
+
+    for (const auto& [t, oid] : index_queue)
+    {
+        if ( t >= actual_time )
+        {
+            break;
+        }
+
+        const auto& entry = index_entries[oid];
+
+        if ( entry.type == ot )
+        {
+            actions.emplace_back(oid, entry.parent_id);
+        }
+    }
+
+    return actions;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+class sched_index_cb : public Callbackable
 {
 public:
-    void set_callback(std::vector<std::pair<T1, T2>> * _map)
+    void set_callback(std::vector<std::tuple<int, int, std::string, time_t>> * _rows)
     {
-        result = _map;
+        rows = _rows;
 
         Callbackable::set_callback(
-                static_cast<Callbackable::Callback>(&vector_pair_cb::callback), 0);
+                static_cast<Callbackable::Callback>(&sched_index_cb::callback), 0);
     };
 
     int callback(void * nil, int num, char **values, char **names)
     {
-        if ( num < 2 || values == 0 || values[0] == 0 || values[1] == 0)
+        if ( num < 4 || values == 0 || values[0] == 0 || values[1] == 0 ||
+             values[2] == 0 || values[3] == 0 )
         {
             return -1;
         }
 
-        T1 key;
-        T2 value;
+        int    oid;
+        int    parent_id;
+        time_t t;
 
-        one_util::str_cast(values[0], key);
-        one_util::str_cast(values[1], value);
+        one_util::str_cast(values[0], oid);
+        one_util::str_cast(values[1], parent_id);
+        one_util::str_cast(values[3], t);
 
-        result->push_back(std::make_pair(key, value));
+        rows->emplace_back(oid, parent_id, values[2], t);
 
         return 0;
     };
 
 private:
-
-    std::vector<std::pair<T1, T2>> * result = nullptr;
+    std::vector<std::tuple<int, int, std::string, time_t>> * rows = nullptr;
 };
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-std::vector<std::pair<int, int>> ScheduledActionPool::get_is_due_actions(PoolObjectSQL::ObjectType ot)
+void ScheduledActionPool::load_index()
 {
-    ostringstream   sql;
+    ostringstream sql;
 
-    time_t actual_time = time(0);
+    std::vector<std::tuple<int, int, std::string, time_t>> rows;
 
-    vector_pair_cb<int, int> cb;
-    std::vector<std::pair<int, int>> actions;
-    cb.set_callback(&actions);
+    sched_index_cb cb;
+
+    cb.set_callback(&rows);
 
-    sql << "SELECT oid, parent_id FROM " <<  one_db::scheduled_action_table
-        << " WHERE type = '" << PoolObjectSQL::type_to_str(ot) << "'"
-        << " AND time < " << actual_time
-        << " AND time > done "
-        << " ORDER BY time";
+    sql << "SELECT oid, parent_id, type, time FROM "
+        << one_db::scheduled_action_table << " WHERE time > done";
 
-    db->exec_rd(sql, &cb);
+    int rc = db->exec_rd(sql, &cb);
 
     cb.unset_callback();
 
-    return actions;
+    index_entries.clear();
+    index_queue.clear();
+
+    if ( rc != 0 )
+    {
+        NebulaLog::error("SCH", "Error loading scheduled actions index");
+        return;
+    }
+
+    for (const auto& [oid, parent_id, type, t] : rows)
+    {
+        index_entries[oid] = {PoolObjectSQL::str_to_type(type), parent_id, t};
+        index_queue.emplace(t, oid);
+    }
+
+    index_valid = true;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void ScheduledActionPool::index_set(int oid, PoolObjectSQL::ObjectType type,
+                                    int parent_id, time_t t, time_t done)
+{
+    lock_guard<mutex> lock(index_mutex);
+
+    if (!index_valid)
+    {
+        return;
+    }
+
+    auto it = index_entries.find(oid);
+
+    if ( it != index_entries.end() )
+    {
+        index_queue.erase(make_pair(it->second.time, oid));
+        index_entries.erase(it);
+    }
+
+    if ( t > done )
+    {
+        index_entries[oid] = {type, parent_id, t};
+        index_queue.emplace(t, oid);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void ScheduledActionPool::index_remove(int oid)
+{
+    lock_guard<mutex> lock(index_mutex);
+
+    auto it = index_entries.find(oid);
+
+    if ( it != index_entries.end() )
+    {
+        index_queue.erase(make_pair(it->second.time, oid));
+        index_entries.erase(it);
+    }
 }
 
 /* -------------------------------------------------------------------------- */
@@ -105,6 +105,8 @@ int SchedulerManager::load_drivers(const std::vector<const VectorAttribute*>& _m
 
     sched_conf.replace("NAME", driver_name);
 
+    sched_conf.vector_value("DELTA", delta_input);
+
     if ( load_driver(&sched_conf) != 0 )
     {
         NebulaLog::error("SCM", "Unable to load Scheduler Manager driver");
@@ -148,12 +150,15 @@ void SchedulerManager::trigger_place()
 
             ++wnd_length;
 
-            std::ostringstream oss;
+            if ( NebulaLog::log_level() >= Log::DDEBUG )
+            {
+                std::ostringstream oss;
 
-            oss << "Scheduler window length " << the_time - wnd_start << "s and "
-                << wnd_length << " VMs";
+                oss << "Scheduler window length " << the_time - wnd_start
+                    << "s and " << wnd_length << " VMs";
 
-            NebulaLog::ddebug("SCM", oss.str());
+                NebulaLog::ddebug("SCM", oss.str());
+            }
 
             if (the_time < (wnd_start + max_wnd_time) &&
                     wnd_length < max_wnd_length)
@@ -175,7 +180,7 @@ void SchedulerManager::trigger_place()
             return;
         }
 
-        scheduler->place();
+        scheduler->place(delta_input);
     });
 }
 
@@ -237,7 +242,7 @@ void SchedulerManager::place_finished()
         return;
     }
 
-    scheduler->place();
+    scheduler->place(delta_input);
 }
 
 void SchedulerManager::timer_action()
@@ -276,17 +281,21 @@ void SchedulerManager::timer_action()
         bool pending = (vmids.size() > 0) &&
                        (the_time >= last_place + retry_time);
 
-        std::ostringstream oss;
+        if ( NebulaLog::log_level() >= Log::DDEBUG )
+        {
+            std::ostringstream oss;
 
-        time_t wt = (wnd_start == 0) ? 0 : (the_time - wnd_start);
-        time_t rt = last_place + retry_time - the_time;
+            time_t wt = (wnd_start == 0) ? 0 : (the_time - wnd_start);
+            time_t rt = last_place + retry_time - the_time;
 
-        rt = (rt < 0) ? 0 : rt;
+            rt = (rt < 0) ? 0 : rt;
 
-        oss << "Scheduler window length " << wt << "s and " << wnd_length << " VMs"
-            << ". Pending VMs: " << vmids.size() << " time to retry: " << rt;
+            oss << "Scheduler window length " << wt << "s and " << wnd_length
+                << " VMs. Pending VMs: " << vmids.size() << " time to retry: "
+                << rt;
 
-        NebulaLog::ddebug("SCMT", oss.str());
+            NebulaLog::ddebug("SCMT", oss.str());
+        }
 
         //TODO Check there is no placement plan active
 
@@ -307,7 +316,7 @@ void SchedulerManager::timer_action()
         return;
     }
 
-    scheduler->place();
+    scheduler->place(delta_input);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -318,6 +327,11 @@ void SchedulerManager::timer_action()
 /* -------------------------------------------------------------------------- */
 static void log_msg(scheduler_msg_t *msg)
 {
+    if ( NebulaLog::log_level() < Log::DDEBUG )
+    {
+        return;
+    }
+
     std::ostringstream oss;
 
     oss << "Message received: ";
@@ -362,6 +376,35 @@ void SchedulerManager::_place(std::unique_ptr<scheduler_msg_t> msg)
     {
         std::ostringstream oss;
 
+        if ( msg->payload() == SchedulerManagerDriver::delta_resync )
+        {
+            NebulaLog::info("SCM", "Scheduler driver requested a full host "
+                            "pool, retrying placement.");
+
+            trigger([this]
+            {
+                RaftManager * raftm = Nebula::instance().get_raftm();
+
+                if (!raftm || (!raftm->is_leader() && !raftm->is_solo()))
+                {
+                    return;
+                }
+
+                auto scheduler = get();
+
+                if (scheduler == nullptr)
+                {
+                    return;
+                }
+
+                scheduler->reset_delta();
+
+                scheduler->place(delta_input);
+            });
+
+            return;
+        }
+
         oss << "Scheduler place operation error: " << msg->payload();
         NebulaLog::log("SCM", Log::INFO, oss);
 
@@ -21,6 +21,7 @@
 #include "VMGroupPool.h"
 #include "ClusterPool.h"
 #include "Nebula.h"
+#include "HostShareCapacity.h"
 
 SchedulerManagerDriver::SchedulerManagerDriver(const std::string& c,
         const std::string& a, int ct): Driver(c, a, ct)
@@ -38,15 +39,19 @@ SchedulerManagerDriver::SchedulerManagerDriver(const std::string& c,
 
 /* -------------------------------------------------------------------------- */
 
-void SchedulerManagerDriver::place() const
+void SchedulerManagerDriver::place(bool delta) const
 {
     SchedRequest sr(vmpool, hpool, dspool, vnpool, upool, clpool);
 
+    auto start = SchedProfile::now();
+
     if ( setup_place_pools(sr) == -1 )
     {
         return;
     }
 
+    sr.profile.add("pools", start);
+
     match(sr, "Cannot dispatch VM: ");
 
     if (sr.match.vms.empty())
@@ -56,20 +61,30 @@ void SchedulerManagerDriver::place() const
 
     std::ostringstream oss;
 
-    scheduler_message(sr, oss);
+    start = SchedProfile::now();
+
+    scheduler_message(sr, oss, delta);
+
+    sr.profile.add("message", start);
 
     place(oss);
+
+    log_profile(sr, "Placement");
 }
 
 void SchedulerManagerDriver::optimize(int cluster_id) const
 {
     SchedRequest sr(vmpool, hpool, dspool, vnpool, upool, clpool);
 
+    auto start = SchedProfile::now();
+
     if ( setup_optimize_pools(cluster_id, sr) == -1 )
     {
         return;
     }
 
+    sr.profile.add("pools", start);
+
     match(sr, "Optimize: ");
 
     if (sr.match.vms.empty())
@@ -79,15 +94,35 @@ void SchedulerManagerDriver::optimize(int cluster_id) const
 
     std::ostringstream oss;
 
+    start = SchedProfile::now();
+
     scheduler_message(sr, oss);
 
+    sr.profile.add("message", start);
+
     optimize(cluster_id, oss);
+
+    log_profile(sr, "Optimize cluster " + std::to_string(cluster_id));
+}
+
+void SchedulerManagerDriver::log_profile(const SchedRequest& sr,
+                                         const std::string& request) const
+{
+    std::ostringstream oss;
+
+    oss << request << " request with " << sr.vmpool.ids.size() << " VMs ("
+        << sr.match.vms.size() << " matched) and " << sr.hpool.ids.size()
+        << " hosts. " << sr.profile.to_str();
+
+    NebulaLog::log("SCM", Log::DEBUG, oss);
 }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-int SchedulerManagerDriver::scheduler_message(SchedRequest& sr, std::ostringstream& oss) const
+int SchedulerManagerDriver::scheduler_message(SchedRequest& sr,
+                                              std::ostringstream& oss,
+                                              bool delta) const
 {
     std::string temp;
 
@@ -95,7 +130,14 @@ int SchedulerManagerDriver::scheduler_message(SchedRequest& sr, std::ostringstre
 
     sr.vmpool.to_xml(oss, sr.match.vms);
 
-    sr.hpool.to_xml(oss, sr.match.match_host);
+    if ( delta )
+    {
+        host_pool_delta(sr, oss);
+    }
+    else
+    {
+        sr.hpool.to_xml(oss, sr.match.match_host);
+    }
 
     //Include Image and System datastores to compute SELF LN/CP methods
     dspool->dump(temp, "", 0, -1, false);
@@ -134,6 +176,70 @@ int SchedulerManagerDriver::scheduler_message(SchedRequest& sr, std::ostringstre
     return 0;
 }
 
+/* -------------------------------------------------------------------------- */
+
+void SchedulerManagerDriver::host_pool_delta(SchedRequest& sr,
+                                             std::ostringstream& oss) const
+{
+    std::lock_guard<std::mutex> lock(delta_mutex);
+
+    std::map<int, size_t> hosts;
+
+    std::ostringstream keep;
+    std::string tmp;
+
+    bool full = delta_reset.exchange(false);
+
+    if ( full )
+    {
+        sent_hosts.clear();
+    }
+
+    oss << "<HOST_POOL>";
+
+    for (int hid : sr.match.match_host)
+    {
+        Host * host = sr.hpool.get(hid);
+
+        if ( host == nullptr )
+        {
+            continue;
+        }
+
+        // Host body, monitoring and cluster template are rendered in the host
+        size_t digest = std::hash<uint64_t>()(hpool->get_write_version(hid));
+
+        digest ^= std::hash<time_t>()(host->get_monitoring().timestamp())
+            + 0x9e3779b9 + (digest << 6) + (digest >> 2);
+
+        digest ^= std::hash<std::string>()(host->cluster_template())
+            + 0x9e3779b9 + (digest << 6) + (digest >> 2);
+
+        hosts.emplace(hid, digest);
+
+        auto it = sent_hosts.find(hid);
+
+        if ( it != sent_hosts.end() && it->second == digest )
+        {
+            keep << "<ID>" << hid << "</ID>";
+        }
+        else
+        {
+            oss << host->to_xml(tmp);
+        }
+    }
+
+    oss << "</HOST_POOL>";
+
+    oss << "<HOST_POOL_DELTA>"
+        << "<SEQ>"  << ++delta_seq << "</SEQ>"
+        << "<FULL>" << full << "</FULL>"
+        << "<KEEP>" << keep.str() << "</KEEP>"
+        << "</HOST_POOL_DELTA>";
+
+    sent_hosts.swap(hosts);
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -190,6 +296,16 @@ int SchedulerManagerDriver::setup_place_pools(SchedRequest &sr) const
         return -1;
     }
 
+    filter_host_capacity(sr);
+
+    if ( sr.hpool.ids.empty() )
+    {
+        sr.vmpool.each_id([this](int id) {
+            log_vm(id, "Cannot dispatch VM: No hosts with enough capacity to run VMs");
+        });
+        return -1;
+    }
+
     sr.merge_cluster_to_host();
 
     // -------------------------------------------------------------------------
@@ -244,6 +360,79 @@ int SchedulerManagerDriver::setup_place_pools(SchedRequest &sr) const
     return 0;
 }
 
+/* -------------------------------------------------------------------------- */
+
+void SchedulerManagerDriver::filter_host_capacity(SchedRequest& sr) const
+{
+    long long min_cpu = -1;
+    long long min_mem = -1;
+
+    for (int vm_id: sr.vmpool.ids)
+    {
+        VirtualMachine * vm = sr.vmpool.get(vm_id);
+
+        if ( vm == nullptr )
+        {
+            continue;
+        }
+
+        HostShareCapacity hsc;
+
+        vm->get_capacity(hsc);
+
+        if ( min_cpu == -1 || hsc.cpu < min_cpu )
+        {
+            min_cpu = hsc.cpu;
+        }
+
+        if ( min_mem == -1 || hsc.mem < min_mem )
+        {
+            min_mem = hsc.mem;
+        }
+    }
+
+    if ( min_cpu <= 0 && min_mem <= 0 )
+    {
+        return;
+    }
+
+    std::vector<HostPool::Capacity> records;
+
+    uint64_t epoch = 0;
+
+    hpool->get_capacity(epoch, 0, records);
+
+    std::map<int, const HostPool::Capacity *> capacity;
+
+    for (const auto& record : records)
+    {
+        capacity.emplace(record.oid, &record);
+    }
+
+    // Hosts not in the snapshot are kept, the scheduler will check them.
+    // A resource is only checked if all the VMs request it, so overcommitted
+    // hosts are not discarded for VMs that do not need that resource.
+    auto no_room = [min_cpu, min_mem](const HostPool::Capacity * c)
+    {
+        return (min_cpu > 0 && (c->max_cpu - c->cpu_usage) < min_cpu) ||
+               (min_mem > 0 && (c->max_mem - c->mem_usage) < min_mem);
+    };
+
+    for (auto it = sr.hpool.ids.begin(); it != sr.hpool.ids.end(); )
+    {
+        auto cit = capacity.find(*it);
+
+        if ( cit != capacity.end() && no_room(cit->second) )
+        {
+            it = sr.hpool.ids.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 int SchedulerManagerDriver::setup_optimize_pools(int cluster_id, SchedRequest& sr) const
 {
     // -------------------------------------------------------------------------
@@ -356,7 +545,7 @@ static std::string * build_requirements(std::string& ar, std::string& r)
 static int authorize(VirtualMachine * vm,
                       PoolObjectSQL *obj,
                       AuthRequest::Operation op,
-                      SchedPool<UserPool, User>& upool)
+                      SchedRequest& sr)
 {
     static auto aclm = Nebula::instance().get_aclm();
 
@@ -365,33 +554,60 @@ static int authorize(VirtualMachine * vm,
         return 1;
     }
 
-    PoolObjectAuth perms;
+    auto key = std::make_tuple(vm->get_uid(), static_cast<int>(obj->get_type()),
+                               obj->get_oid(), static_cast<int>(op));
 
-    obj->get_permissions(perms);
+    auto it = sr.auth_cache.find(key);
+
+    if (it != sr.auth_cache.end())
+    {
+        return it->second;
+    }
 
-    User * user = upool.get(vm->get_uid());
+    int rc = 1;
+
+    User * user = sr.upool.get(vm->get_uid());
 
     if (user == nullptr)
     {
-        return 2;
+        rc = 2;
     }
-
-    if(!aclm->authorize(vm->get_uid(), user->get_groups(), perms, op))
+    else
     {
-        return 0;
+        PoolObjectAuth perms;
+
+        obj->get_permissions(perms);
+
+        if(!aclm->authorize(vm->get_uid(), user->get_groups(), perms, op))
+        {
+            rc = 0;
+        }
     }
 
-    return 1;
+    sr.auth_cache.emplace(key, rc);
+
+    return rc;
 }
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 
-static int match_hosts(SchedRequest& sr, VirtualMachine * vm, std::string& error);
+typedef SchedRequirements<HostPool, Host> HostRequirements;
+
+typedef SchedRequirements<DatastorePool, Datastore> DatastoreRequirements;
+
+typedef SchedRequirements<VirtualNetworkPool, VirtualNetwork> NetworkRequirements;
+
+static std::string host_requirements(VirtualMachine * vm);
+
+static int match_hosts(SchedRequest& sr, VirtualMachine * vm,
+                       HostRequirements& reqs, std::string& error);
 
-static int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error);
+static int match_system_ds(SchedRequest& sr, VirtualMachine * vm,
+                           DatastoreRequirements& reqs, std::string& error);
 
-static int match_networks(SchedRequest& sr, VirtualMachine * vm, std::string& error);
+static int match_networks(SchedRequest& sr, VirtualMachine * vm,
+                          NetworkRequirements& reqs, std::string& error);
 
 static AuthRequest::Operation get_vm_auth_op(VMActions::Action action);
 
@@ -400,6 +616,14 @@ void SchedulerManagerDriver::match(SchedRequest& sr, const std::string& ebase) c
     int rc;
     std::string error;
 
+    HostRequirements      host_reqs(sr.hpool);
+    DatastoreRequirements ds_reqs(sr.dspool);
+    NetworkRequirements   net_reqs(sr.vnpool);
+
+    std::vector<VirtualMachine *> vms;
+
+    auto start = SchedProfile::now();
+
     for(int vm_id: sr.vmpool.ids)
     {
         VirtualMachine * vm = sr.vmpool.get(vm_id);
@@ -419,7 +643,26 @@ void SchedulerManagerDriver::match(SchedRequest& sr, const std::string& ebase) c
             continue;
         }
 
-        rc = match_hosts(sr, vm, error);
+        host_reqs.add(host_requirements(vm));
+
+        vms.push_back(vm);
+    }
+
+    // Host requirements are evaluated in parallel, system datastores and
+    // networks are evaluated on demand and cached for the next VMs
+    host_reqs.evaluate(std::thread::hardware_concurrency());
+
+    sr.profile.add("host requirements", start);
+
+    for (auto vm : vms)
+    {
+        int vm_id = vm->get_oid();
+
+        start = SchedProfile::now();
+
+        rc = match_hosts(sr, vm, host_reqs, error);
+
+        sr.profile.add("host match", start);
 
         if ( rc == -1 )
         {
@@ -431,7 +674,11 @@ void SchedulerManagerDriver::match(SchedRequest& sr, const std::string& ebase) c
             continue;
         }
 
-        rc = match_system_ds(sr, vm, error);
+        start = SchedProfile::now();
+
+        rc = match_system_ds(sr, vm, ds_reqs, error);
+
+        sr.profile.add("datastore match", start);
 
         if ( rc == -1 )
         {
@@ -443,7 +690,11 @@ void SchedulerManagerDriver::match(SchedRequest& sr, const std::string& ebase) c
             continue;
         }
 
-        rc = match_networks(sr, vm, error);
+        start = SchedProfile::now();
+
+        rc = match_networks(sr, vm, net_reqs, error);
+
+        sr.profile.add("network match", start);
 
         if ( rc == -1 )
         {
@@ -490,25 +741,33 @@ void SchedulerManagerDriver::match(SchedRequest& sr, const std::string& ebase) c
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
-int match_hosts(SchedRequest& sr, VirtualMachine * vm, std::string& error)
-{
-    int n_auth  = 0;
-    int n_match = 0;
 
-    error.clear();
-
-    // -------------------------------------------------------------------------
-    // Prepare VM requirements expression for Host matching
-    // -------------------------------------------------------------------------
+std::string host_requirements(VirtualMachine * vm)
+{
     std::string areqs, reqs;
 
     vm->get_user_template_attribute("SCHED_REQUIREMENTS", reqs);
     vm->get_template_attribute("AUTOMATIC_REQUIREMENTS", areqs);
 
-    std::string *requirements = build_requirements(areqs, reqs);
+    return *build_requirements(areqs, reqs);
+}
+
+// -----------------------------------------------------------------------------
+
+int match_hosts(SchedRequest& sr, VirtualMachine * vm, HostRequirements& reqs,
+                std::string& error)
+{
+    int n_auth  = 0;
+    int n_match = 0;
 
-    for (int host_id: sr.hpool.ids)
+    error.clear();
+
+    std::string requirements = host_requirements(vm);
+
+    for (size_t i = 0; i < sr.hpool.ids.size(); ++i)
     {
+        int host_id = sr.hpool.ids[i];
+
         Host * host = sr.hpool.get(host_id);
 
         if (host == nullptr)
@@ -526,7 +785,7 @@ int match_hosts(SchedRequest& sr, VirtualMachine * vm, std::string& error)
         // ---------------------------------------------------------------------
         // Check if user is authorized to deploy on the host
         // ---------------------------------------------------------------------
-        int auth = authorize(vm, host, AuthRequest::MANAGE, sr.upool);
+        int auth = authorize(vm, host, AuthRequest::MANAGE, sr);
 
         if (auth == 0)
         {
@@ -540,30 +799,26 @@ int match_hosts(SchedRequest& sr, VirtualMachine * vm, std::string& error)
         n_auth++;
 
         // ---------------------------------------------------------------------
-        // Check if user is authorized to deploy on the host
+        // Evaluate VM requirements
         // ---------------------------------------------------------------------
-        if (!requirements->empty())
-        {
-            char * estr;
-            bool   matched;
+        std::string estr;
 
-            if ( host->eval_bool(*requirements, matched, &estr) != 0 )
-            {
-                std::ostringstream oss;
+        int matched = reqs.test(requirements, i, estr);
 
-                oss << "Error in SCHED_REQUIREMENTS: '" << *requirements
-                    << "', error: " << estr;
+        if (matched == -1)
+        {
+            std::ostringstream oss;
 
-                error = oss.str();
+            oss << "Error in SCHED_REQUIREMENTS: '" << requirements
+                << "', error: " << estr;
 
-                free(estr);
-                return -1;
-            }
+            error = oss.str();
 
-            if (matched == false)
-            {
-                continue;
-            }
+            return -1;
+        }
+        else if (matched == 0)
+        {
+            continue;
         }
 
         sr.match.add_host(vm->get_oid(), host_id);
@@ -587,7 +842,8 @@ int match_hosts(SchedRequest& sr, VirtualMachine * vm, std::string& error)
 
 // -----------------------------------------------------------------------------
 
-int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error)
+int match_system_ds(SchedRequest& sr, VirtualMachine * vm,
+                    DatastoreRequirements& reqs, std::string& error)
 {
     int n_auth  = 0;
     int n_match = 0;
@@ -607,15 +863,17 @@ int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error)
     // -------------------------------------------------------------------------
     // Prepare VM requirements expression for Host matching
     // -------------------------------------------------------------------------
-    std::string areqs, reqs;
+    std::string areqs, reqs_str;
 
-    vm->get_user_template_attribute("SCHED_DS_REQUIREMENTS", reqs);
+    vm->get_user_template_attribute("SCHED_DS_REQUIREMENTS", reqs_str);
     vm->get_template_attribute("AUTOMATIC_DS_REQUIREMENTS", areqs);
 
-    std::string *requirements = build_requirements(areqs, reqs);
+    std::string *requirements = build_requirements(areqs, reqs_str);
 
-    for (int ds_id: sr.dspool.ids)
+    for (size_t i = 0; i < sr.dspool.ids.size(); ++i)
     {
+        int ds_id = sr.dspool.ids[i];
+
         Datastore * ds = sr.dspool.get(ds_id);
 
         if (ds == nullptr)
@@ -626,7 +884,7 @@ int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error)
         // ---------------------------------------------------------------------
         // Check if user is authorized
         // ---------------------------------------------------------------------
-        int auth = authorize(vm, ds, AuthRequest::USE, sr.upool);
+        int auth = authorize(vm, ds, AuthRequest::USE, sr);
 
         if (auth == 0)
         {
@@ -642,28 +900,24 @@ int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error)
         // ---------------------------------------------------------------------
         // Evaluate VM requirements
         // ---------------------------------------------------------------------
-        if (!requirements->empty())
-        {
-            char * estr;
-            bool   matched;
+        std::string estr;
 
-            if ( ds->eval_bool(*requirements, matched, &estr) != 0 )
-            {
-                std::ostringstream oss;
+        int matched = reqs.test(*requirements, i, estr);
 
-                oss << "Error in SCHED_DS_REQUIREMENTS: '" << requirements
-                    << "', error: " << estr;
+        if (matched == -1)
+        {
+            std::ostringstream oss;
 
-                error = oss.str();
+            oss << "Error in SCHED_DS_REQUIREMENTS: '" << *requirements
+                << "', error: " << estr;
 
-                free(estr);
-                return -1;
-            }
+            error = oss.str();
 
-            if (matched == false)
-            {
-                continue;
-            }
+            return -1;
+        }
+        else if (matched == 0)
+        {
+            continue;
         }
 
         sr.match.add_ds(vm->get_oid(), ds_id);
@@ -687,7 +941,8 @@ int match_system_ds(SchedRequest& sr, VirtualMachine * vm, std::string& error)
 
 // -----------------------------------------------------------------------------
 
-int match_networks(SchedRequest& sr, VirtualMachine * vm, std::string& error)
+int match_networks(SchedRequest& sr, VirtualMachine * vm,
+                   NetworkRequirements& reqs, std::string& error)
 {
     error.clear();
 
@@ -719,18 +974,25 @@ int match_networks(SchedRequest& sr, VirtualMachine * vm, std::string& error)
             continue;
         }
 
-        std::string reqs = nic->vector_value("SCHED_REQUIREMENTS");
+        std::string nic_reqs = nic->vector_value("SCHED_REQUIREMENTS");
 
-        std::string *requirements = build_requirements(areqs, reqs);
+        std::string *requirements = build_requirements(areqs, nic_reqs);
 
-        for (int net_id: sr.vnpool.ids)
+        for (size_t i = 0; i < sr.vnpool.ids.size(); ++i)
         {
+            int net_id = sr.vnpool.ids[i];
+
             VirtualNetwork * net = sr.vnpool.get(net_id);
 
+            if (net == nullptr)
+            {
+                continue;
+            }
+
             // -----------------------------------------------------------------
             // Check if user is authorized
             // -----------------------------------------------------------------
-            int auth = authorize(vm, net, AuthRequest::USE, sr.upool);
+            int auth = authorize(vm, net, AuthRequest::USE, sr);
 
             if (auth == 0)
             {
@@ -746,28 +1008,24 @@ int match_networks(SchedRequest& sr, VirtualMachine * vm, std::string& error)
             // -----------------------------------------------------------------
             // Evaluate VM requirements
             // -----------------------------------------------------------------
-            if (!requirements->empty())
-            {
-                char * estr;
-                bool   matched;
+            std::string estr;
 
-                if ( net->eval_bool(*requirements, matched, &estr) != 0 )
-                {
-                    std::ostringstream oss;
+            int matched = reqs.test(*requirements, i, estr);
 
-                    oss << "Error in SCHED_NIC_REQUIREMENTS in NIC " << nic_id
-                        << ": '" << requirements << "', error: " << estr;
+            if (matched == -1)
+            {
+                std::ostringstream oss;
 
-                    error = oss.str();
+                oss << "Error in SCHED_NIC_REQUIREMENTS in NIC " << nic_id
+                    << ": '" << *requirements << "', error: " << estr;
 
-                    free(estr);
-                    return -1;
-                }
+                error = oss.str();
 
-                if (matched == false)
-                {
-                    continue;
-                }
+                return -1;
+            }
+            else if (matched == 0)
+            {
+                continue;
             }
 
             sr.match.add_net(vm->get_oid(), nic_id, net_id);
@@ -37,6 +37,7 @@ $LOAD_PATH << RUBY_LIB_LOCATION
 require 'DriverLogger'
 require 'OpenNebulaDriver'
 require 'getoptlong'
+require 'nokogiri'
 
 # require 'shellwords'
 
@@ -50,6 +51,10 @@ class SchedulerDriver < OpenNebulaDriver
         :optimize => 'OPTIMIZE'
     }
 
+    # Failure sent to oned when the HOST_POOL cannot be rebuilt from the
+    # incremental updates
+    DELTA_RESYNC = 'HOST_POOL_DELTA_RESYNC'
+
     # Init the driver
     def initialize(placer, optimizer, options = {})
         @options={
@@ -67,6 +72,12 @@ class SchedulerDriver < OpenNebulaDriver
         @placer = placer
         @optimizer = optimizer
 
+        # Hosts of the last PLACE request (id => xml), used to rebuild the
+        # HOST_POOL of incremental requests
+        @hosts     = {}
+        @delta_seq = nil
+        @delta_mtx = Mutex.new
+
         placer_path = File.join(@local_scripts_path, @placer)
 
         raise "Scheduler place #{placer} not avialable" unless File.directory?(placer_path)
@@ -85,6 +96,16 @@ class SchedulerDriver < OpenNebulaDriver
     #       <drv_message>
     #   STDIN
     def place(_id, drv_message)
+        begin
+            drv_message = host_pool_delta(drv_message)
+        rescue StandardError => e
+            log(0, "Cannot rebuild HOST_POOL: #{e.message}")
+
+            send_message(ACTION[:place], RESULT[:failure], 0,
+                         Base64.strict_encode64(DELTA_RESYNC))
+            return
+        end
+
         cmd = File.join(@local_scripts_path, @placer, 'place')
         rc  = LocalCommand.run(cmd, log_method(0, :encode => true), drv_message, nil)
 
@@ -107,6 +128,68 @@ class SchedulerDriver < OpenNebulaDriver
         send_message(ACTION[:optimize], result, id, Base64.strict_encode64(info))
     end
 
+    private
+
+    # Rebuilds the HOST_POOL of incremental PLACE requests. oned only includes
+    # the hosts changed since the previous request, and a HOST_POOL_DELTA with
+    # the request sequence number and the ids of the unchanged hosts. Requests
+    # without HOST_POOL_DELTA are returned as is.
+    def host_pool_delta(drv_message)
+        xml = Base64.decode64(drv_message)
+
+        return drv_message unless xml.include?('<HOST_POOL_DELTA>')
+
+        doc   = Nokogiri::XML(xml) {|c| c.strict.noblanks }
+        delta = doc.at_xpath('/SCHEDULER_DRIVER_ACTION/HOST_POOL_DELTA')
+        pool  = doc.at_xpath('/SCHEDULER_DRIVER_ACTION/HOST_POOL')
+
+        return drv_message if delta.nil? || pool.nil?
+
+        seq  = delta.at_xpath('SEQ').text.to_i
+        full = delta.at_xpath('FULL').text == '1'
+        keep = delta.xpath('KEEP/ID').map {|id| id.text.to_i }
+
+        @delta_mtx.synchronize do
+            if !full && (@delta_seq.nil? || seq != @delta_seq + 1)
+                @delta_seq = nil
+                raise "out of sequence request #{seq}"
+            end
+
+            hosts = {}
+
+            keep.each do |id|
+                if !@hosts[id]
+                    @delta_seq = nil
+                    raise "unknown host #{id}"
+                end
+
+                hosts[id] = @hosts[id]
+            end
+
+            pool.xpath('HOST').each do |host|
+                hosts[host.at_xpath('ID').text.to_i] = host.to_xml(
+                    :save_with => Nokogiri::XML::Node::SaveOptions::AS_XML
+                )
+            end
+
+            @hosts     = hosts
+            @delta_seq = seq
+
+            delta.remove
+            pool.children.remove
+
+            xml = doc.root.to_xml(
+                :save_with => Nokogiri::XML::Node::SaveOptions::AS_XML
+            )
+
+            xml.sub!(%r{<HOST_POOL\s*/>|<HOST_POOL></HOST_POOL>}) do
+                "<HOST_POOL>#{hosts.values.join}</HOST_POOL>"
+            end
+        end
+
+        Base64.strict_encode64(xml)
+    end
+
 end
 
 ################################################################################
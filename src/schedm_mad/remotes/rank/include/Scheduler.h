@@ -22,6 +22,7 @@
 #include "DatastorePoolXML.h"
 #include "VirtualMachinePoolXML.h"
 #include "VirtualNetworkPoolXML.h"
+#include "VMGroupAffinity.h"
 #include "SchedulerPolicy.h"
 #include "Listener.h"
 
@@ -85,6 +86,12 @@ protected:
 
     std::shared_ptr<VMGroupPoolXML> vmgpool = nullptr;
 
+    /**
+     *  Host of the running and dispatched VMs, used to evaluate VM group
+     *  affinity rules
+     */
+    VMPlacementIndex placements;
+
     // ---------------------------------------------------------------
     // Scheduler Policies
     // ---------------------------------------------------------------
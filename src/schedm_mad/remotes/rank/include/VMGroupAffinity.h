@@ -0,0 +1,422 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+#ifndef VMGROUP_AFFINITY_H_
+#define VMGROUP_AFFINITY_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+/**
+ *  Set of host IDs stored as a bitset, indexed by host ID
+ */
+class HostBitset
+{
+public:
+    void set(int hid)
+    {
+        if ( hid < 0 )
+        {
+            return;
+        }
+
+        size_t w = hid / 64;
+
+        if ( w >= bits.size() )
+        {
+            bits.resize(w + 1, 0);
+        }
+
+        bits[w] |= (uint64_t{1} << (hid % 64));
+    }
+
+    void set(const std::set<int>& hids)
+    {
+        for (auto hid : hids)
+        {
+            set(hid);
+        }
+    }
+
+    bool test(int hid) const
+    {
+        if ( hid < 0 )
+        {
+            return false;
+        }
+
+        size_t w = hid / 64;
+
+        return w < bits.size() && (bits[w] & (uint64_t{1} << (hid % 64))) != 0;
+    }
+
+    /**
+     *  Keeps the hosts included in both sets
+     */
+    void intersect(const HostBitset& hb)
+    {
+        if ( bits.size() > hb.bits.size() )
+        {
+            bits.resize(hb.bits.size());
+        }
+
+        for (size_t i = 0; i < bits.size(); ++i)
+        {
+            bits[i] &= hb.bits[i];
+        }
+    }
+
+    /**
+     *  Adds the hosts in the given set
+     */
+    void merge(const HostBitset& hb)
+    {
+        if ( bits.size() < hb.bits.size() )
+        {
+            bits.resize(hb.bits.size(), 0);
+        }
+
+        for (size_t i = 0; i < hb.bits.size(); ++i)
+        {
+            bits[i] |= hb.bits[i];
+        }
+    }
+
+    bool none() const
+    {
+        for (auto w : bits)
+        {
+            if ( w != 0 )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void clear()
+    {
+        bits.clear();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const HostBitset& hb)
+    {
+        bool first = true;
+
+        os << "[";
+
+        for (size_t i = 0; i < hb.bits.size() * 64; ++i)
+        {
+            if ( hb.test(i) )
+            {
+                os << (first ? "" : ",") << i;
+                first = false;
+            }
+        }
+
+        os << "]";
+
+        return os;
+    }
+
+private:
+    std::vector<uint64_t> bits;
+};
+
+/**
+ *  Index of the host of each VM. It includes the VMs running in the hosts and
+ *  the VMs dispatched by the scheduler.
+ */
+class VMPlacementIndex
+{
+public:
+    void add(int vm_id, int hid)
+    {
+        placement[vm_id] = hid;
+    }
+
+    /**
+     *  Adds to the bitset the hosts running any of the VMs
+     *    @param except VM ID not considered
+     */
+    void hosts(const std::set<int>& vms, HostBitset& hb, int except = -1) const
+    {
+        for (auto vm_id : vms)
+        {
+            if ( vm_id == except )
+            {
+                continue;
+            }
+
+            auto it = placement.find(vm_id);
+
+            if ( it != placement.end() )
+            {
+                hb.set(it->second);
+            }
+        }
+    }
+
+    void clear()
+    {
+        placement.clear();
+    }
+
+private:
+    std::unordered_map<int, int> placement;
+};
+
+/**
+ *  VM group placement rules of a VM. Rules are evaluated as host sets once per
+ *  VM and placement, instead of adding boolean expressions (host and VM ID
+ *  lists) to the VM requirements and evaluating them for every host.
+ *
+ *  A host fulfills the rules if:
+ *    - It is included in every affined host set
+ *    - It is not included in the anti-affined host set
+ *    - It runs a VM of every affined VM set
+ *    - It does not run any VM of the anti-affined VM set
+ */
+class VMGroupAffinity
+{
+public:
+    /**
+     *  Adds a host set rule, empty sets are ignored
+     *    @param hosts the set of host IDs
+     *    @param affined true if the VM needs to be placed in one of the hosts
+     *    false if the VM can't be placed in any of the hosts
+     */
+    void add_hosts(const std::set<int>& hosts, bool affined)
+    {
+        if ( hosts.empty() )
+        {
+            return;
+        }
+
+        if ( affined )
+        {
+            HostBitset hb;
+
+            hb.set(hosts);
+
+            hosts_in.push_back(std::move(hb));
+        }
+        else
+        {
+            hosts_out.set(hosts);
+        }
+    }
+
+    /**
+     *  Adds a VM set rule, empty sets are ignored
+     *    @param vms the set of VM IDs
+     *    @param affined true if the VM needs to be placed with one of the VMs
+     *    false if the VM can't be placed with any of the VMs
+     */
+    void add_vms(const std::set<int>& vms, bool affined)
+    {
+        if ( vms.empty() )
+        {
+            return;
+        }
+
+        if ( affined )
+        {
+            vms_in.push_back(vms);
+        }
+        else
+        {
+            vms_out.push_back({std::make_shared<const std::set<int>>(vms), -1});
+        }
+    }
+
+    /**
+     *  Adds an anti-affined VM set rule. The set is shared, not copied, so the
+     *  VMs of a role can use the same set.
+     *    @param vms the set of VM IDs
+     *    @param vm_id of this VM, it is not considered in the set
+     */
+    void add_vms_out(const std::shared_ptr<const std::set<int>>& vms, int vm_id)
+    {
+        if ( vms->empty() || (vms->size() == 1 && vms->count(vm_id) == 1) )
+        {
+            return;
+        }
+
+        vms_out.push_back({vms, vm_id});
+    }
+
+    /**
+     *  Adds (logical AND) the rules of other VM
+     */
+    void merge(const VMGroupAffinity& va)
+    {
+        hosts_in.insert(hosts_in.end(), va.hosts_in.begin(), va.hosts_in.end());
+
+        hosts_out.merge(va.hosts_out);
+
+        vms_in.insert(vms_in.end(), va.vms_in.begin(), va.vms_in.end());
+
+        vms_out.insert(vms_out.end(), va.vms_out.begin(), va.vms_out.end());
+    }
+
+    bool empty() const
+    {
+        return hosts_in.empty() && vms_in.empty() && vms_out.empty() &&
+               hosts_out.none();
+    }
+
+    /**
+     *  Computes the allowed hosts for the current placement of the VMs. It
+     *  needs to be called before test() if the placement changes.
+     */
+    void set_placement(const VMPlacementIndex& index)
+    {
+        include.clear();
+        exclude.clear();
+
+        restricted = !hosts_in.empty() || !vms_in.empty();
+
+        bool first = true;
+
+        for (const auto& hb : hosts_in)
+        {
+            if ( first )
+            {
+                include = hb;
+                first   = false;
+            }
+            else
+            {
+                include.intersect(hb);
+            }
+        }
+
+        for (const auto& vms : vms_in)
+        {
+            HostBitset hb;
+
+            index.hosts(vms, hb);
+
+            if ( first )
+            {
+                include = std::move(hb);
+                first   = false;
+            }
+            else
+            {
+                include.intersect(hb);
+            }
+        }
+
+        exclude = hosts_out;
+
+        for (const auto& vs : vms_out)
+        {
+            index.hosts(*vs.vms, exclude, vs.except);
+        }
+    }
+
+    /**
+     *  @return true if the host fulfills the rules for the placement set by
+     *  the last set_placement() call
+     */
+    bool test(int hid) const
+    {
+        return (!restricted || include.test(hid)) && !exclude.test(hid);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const VMGroupAffinity& va)
+    {
+        for (const auto& hb : va.hosts_in)
+        {
+            os << "HOSTS IN " << hb << " ";
+        }
+
+        if ( !va.hosts_out.none() )
+        {
+            os << "HOSTS OUT " << va.hosts_out << " ";
+        }
+
+        for (const auto& vms : va.vms_in)
+        {
+            os << "WITH VMS " << set_to_s(vms) << " ";
+        }
+
+        for (const auto& vs : va.vms_out)
+        {
+            os << "WITHOUT VMS " << set_to_s(*vs.vms, vs.except) << " ";
+        }
+
+        return os;
+    }
+
+private:
+    std::vector<HostBitset> hosts_in;
+
+    HostBitset hosts_out;
+
+    std::vector<std::set<int>> vms_in;
+
+    struct VMSetRule
+    {
+        std::shared_ptr<const std::set<int>> vms;
+
+        int except;
+    };
+
+    std::vector<VMSetRule> vms_out;
+
+    // Allowed hosts for the last placement
+    bool restricted = false;
+
+    HostBitset include;
+
+    HostBitset exclude;
+
+    static std::string set_to_s(const std::set<int>& ids, int except = -1)
+    {
+        std::ostringstream oss;
+
+        bool first = true;
+
+        oss << "[";
+
+        for (auto id : ids)
+        {
+            if ( id == except )
+            {
+                continue;
+            }
+
+            oss << (first ? "" : ",") << id;
+            first = false;
+        }
+
+        oss << "]";
+
+        return oss.str();
+    }
+};
+
+#endif /* VMGROUP_AFFINITY_H_ */
@@ -25,6 +25,7 @@
 #include "ObjectXML.h"
 #include "HostPoolXML.h"
 #include "Resource.h"
+#include "VMGroupAffinity.h"
 
 #include "VirtualMachineTemplate.h"
 
@@ -183,6 +184,13 @@ public:
      */
     void add_requirements(const std::string& reqs);
 
+    /**
+     *  VM group placement rules, evaluated in addition to the requirements
+     */
+    VMGroupAffinity& get_affinity() { return affinity; };
+
+    const VMGroupAffinity& get_affinity() const { return affinity; };
+
     //--------------------------------------------------------------------------
     // Functions to schedule network interfaces (NIC)
     //--------------------------------------------------------------------------
@@ -503,6 +511,8 @@ protected:
     std::string rank;
     std::string requirements;
 
+    VMGroupAffinity affinity;
+
     std::string ds_requirements;
     std::string ds_rank;
 
@@ -94,10 +94,11 @@ void VMGroupXML::set_antiaffinity_requirements(std::shared_ptr<VirtualMachinePoo
 
         const std::set<int>& vms = r->get_vms();
 
+        // Shared by all the VMs of the role, each VM skips its own ID
+        auto role_vms = std::make_shared<const std::set<int>>(vms);
+
         for ( auto vm_id : vms )
         {
-            std::string reqs;
-
             VirtualMachineXML * vm = vmpool->get(vm_id);
 
             if ( vm == 0 )
@@ -105,15 +106,10 @@ void VMGroupXML::set_antiaffinity_requirements(std::shared_ptr<VirtualMachinePoo
                 continue;
             }
 
-            r->vm_role_requirements(vm_id, reqs);
-
-            if ( !reqs.empty() )
-            {
-                vm->add_requirements(reqs);
-            }
+            vm->get_affinity().add_vms_out(role_vms, vm_id);
 
-            oss << left << setw(8) << r->id() << left << setw(8) << vm_id << reqs
-                << "\n";
+            oss << left << setw(8) << r->id() << left << setw(8) << vm_id
+                << vm->get_affinity() << "\n";
         }
     }
 
@@ -134,7 +130,7 @@ void VMGroupXML::set_antiaffinity_requirements(std::shared_ptr<VirtualMachinePoo
 
         for ( int i=0 ; i < VMGroupRoles::MAX_ROLES; ++i)
         {
-            string role_reqs;
+            auto role_vms = std::make_shared<std::set<int>>();
 
             if ( rroles[i] == 0 )
             {
@@ -155,23 +151,9 @@ void VMGroupXML::set_antiaffinity_requirements(std::shared_ptr<VirtualMachinePoo
                     continue;
                 }
 
-                std::string reqs;
+                const std::set<int>& vms = r->get_vms();
 
-                r->role_requirements(VMGroupPolicy::ANTI_AFFINED, reqs);
-
-                if ( reqs.empty() )
-                {
-                    continue;
-                }
-
-                if ( role_reqs.empty() )
-                {
-                    role_reqs = reqs;
-                }
-                else
-                {
-                    role_reqs += " & " + reqs;
-                }
+                role_vms->insert(vms.begin(), vms.end());
             }
 
             VMGroupRole * r = roles.get(i);
@@ -192,10 +174,10 @@ void VMGroupXML::set_antiaffinity_requirements(std::shared_ptr<VirtualMachinePoo
                     continue;
                 }
 
-                vm->add_requirements(role_reqs);
+                vm->get_affinity().add_vms_out(role_vms, vm_id);
 
                 oss << left << setw(8) << r->id() << left << setw(8) << vm_id
-                    << vm->get_requirements() << "\n";
+                    << vm->get_affinity() << "\n";
             }
         }
     }
@@ -216,13 +198,13 @@ void VMGroupXML::set_host_requirements(std::shared_ptr<VirtualMachinePoolXML> vm
 
     for ( auto r : roles )
     {
-        std::string areqs, aareqs;
+        std::set<int> ahosts, aahosts;
 
-        r->affined_host_requirements(areqs);
+        r->affined_hosts(ahosts);
 
-        r->antiaffined_host_requirements(aareqs);
+        r->antiaffined_hosts(aahosts);
 
-        if ( r->size_vms() == 0 || (areqs.empty() && aareqs.empty()) )
+        if ( r->size_vms() == 0 || (ahosts.empty() && aahosts.empty()) )
         {
             continue;
         }
@@ -238,18 +220,12 @@ void VMGroupXML::set_host_requirements(std::shared_ptr<VirtualMachinePoolXML> vm
                 continue;
             }
 
-            if ( !areqs.empty() )
-            {
-                vm->add_requirements(areqs);
-            }
+            vm->get_affinity().add_hosts(ahosts, true);
 
-            if ( !aareqs.empty() )
-            {
-                vm->add_requirements(aareqs);
-            }
+            vm->get_affinity().add_hosts(aahosts, false);
 
             oss << left << setw(8) << r->id() << left << setw(8) << vm_id
-                << vm->get_requirements() << "\n";
+                << vm->get_affinity() << "\n";
         }
     }
 }
@@ -314,11 +290,7 @@ static void schecule_affined_set(const std::set<int>& vms,
             return;
         }
 
-        std::ostringstream areqs;
-        std::string areqs_s;
-
-        areqs << "CURRENT_VMS = " << *it;
-        areqs_s = areqs.str();
+        std::set<int> leader = { *it };
 
         for ( ++it ; it != vms.end() ; ++it )
         {
@@ -335,16 +307,17 @@ static void schecule_affined_set(const std::set<int>& vms,
 
             vm->add_capacity(sr);
             vm->add_requirements(tmp->get_requirements());
+            vm->get_affinity().merge(tmp->get_affinity());
             vm->add_affined(*it);
 
-            tmp->add_requirements(areqs_s);
+            tmp->get_affinity().add_vms(leader, true);
 
             oss << left << setw(8) << tmp->get_oid() << " "
-                << tmp->get_requirements() << "\n";
+                << tmp->get_affinity() << "\n";
         }
 
         oss << left << setw(8) << vm->get_oid() << " "
-            << vm->get_requirements() << "\n";
+            << vm->get_requirements() << " " << vm->get_affinity() << "\n";
     }
     else
     {
@@ -352,26 +325,19 @@ static void schecule_affined_set(const std::set<int>& vms,
         /* VMs in the group already running                                   */
         /*   1. Assign VMs to one of the hosts used by the affined set        */
         /* ------------------------------------------------------------------ */
-        std::ostringstream oss_reqs;
-        std::string reqs;
-
-        VMGroupRole::host_requirements(hosts, "=", "|", oss_reqs);
-
-        reqs = oss_reqs.str();
-
         for ( it = vms.begin() ; it != vms.end() ; ++it )
         {
             VirtualMachineXML * vm = vmpool->get(*it);
 
-            if ( vm == 0 || reqs.empty())
+            if ( vm == 0 )
             {
                 continue;
             }
 
-            vm->add_requirements(reqs);
+            vm->get_affinity().add_hosts(hosts, true);
 
             oss << left << setw(8) << vm->get_oid() << " "
-                << vm->get_requirements() << "\n";
+                << vm->get_affinity() << "\n";
         }
     }
 }
@@ -296,8 +296,24 @@ static bool match_host(VirtualMachineXML* vm, HostShareCapacity &sr, HostXML * h
     n_fits++;
 
     // -------------------------------------------------------------------------
-    // Evaluate VM requirements. This needs to be re-evaluated to check
-    // affinity constraints
+    // Check VM group affinity rules
+    // -------------------------------------------------------------------------
+    const VMGroupAffinity& affinity = vm->get_affinity();
+
+    if (!affinity.empty() && !affinity.test(host->get_hid()))
+    {
+        std::ostringstream oss;
+
+        oss << "Host does not fulfill VM group affinity rules: " << affinity;
+
+        error = oss.str();
+        ft    = SchedulerFailure::HOST_AFFINITY;
+
+        return false;
+    }
+
+    // -------------------------------------------------------------------------
+    // Evaluate VM requirements
     // -------------------------------------------------------------------------
     if (!vm->get_requirements().empty())
     {
@@ -433,6 +449,11 @@ void Scheduler::match_schedule()
 
         const auto& prereq_host_ids = vm->get_prereq_host_ids();
 
+        if (!vm->get_affinity().empty())
+        {
+            vm->get_affinity().set_placement(placements);
+        }
+
         int n_match = 0;
         int n_fits  = 0;
 
@@ -787,6 +808,14 @@ void Scheduler::dispatch()
 
         vm->get_capacity(sr);
 
+        // VMs dispatched in previous iterations may change the affinity hosts
+        VMGroupAffinity& affinity = vm->get_affinity();
+
+        if (!affinity.empty())
+        {
+            affinity.set_placement(placements);
+        }
+
         //----------------------------------------------------------------------
         // Get the highest ranked host and best System DS for it
         //----------------------------------------------------------------------
@@ -803,6 +832,15 @@ void Scheduler::dispatch()
 
             auto cid = host->get_cid();
 
+            //------------------------------------------------------------------
+            // Check host still match VM group affinity rules
+            //------------------------------------------------------------------
+            if (!affinity.empty() && !affinity.test(hid))
+            {
+                host_failures[SchedulerFailure::HOST_AFFINITY].insert(hid);
+                continue;
+            }
+
             //------------------------------------------------------------------
             // Check host still match requirements with CURRENT_VMS
             //------------------------------------------------------------------
@@ -1080,6 +1118,8 @@ void Scheduler::dispatch()
             //------------------------------------------------------------------
             host->add_capacity(sr);
 
+            placements.add(vm->get_oid(), hid);
+
             dispatched = true;
 
             break;
@@ -1113,6 +1153,28 @@ void Scheduler::do_vm_groups()
 
     ostringstream oss;
 
+    // -------------------------------------------------------------------------
+    // Index the VMs running in the hosts to evaluate affinity rules
+    // -------------------------------------------------------------------------
+    placements.clear();
+
+    if (!vmgrps.empty())
+    {
+        for (const auto& hit : hpool->get_objects())
+        {
+            auto host = static_cast<HostXML *>(hit.second);
+
+            std::vector<int> vm_ids;
+
+            host->xpaths(vm_ids, "/HOST/VMS/ID");
+
+            for (auto vm_id : vm_ids)
+            {
+                placements.add(vm_id, host->get_hid());
+            }
+        }
+    }
+
     oss << "VM Group Scheduling information\n";
 
     for (auto it = vmgrps.begin(); it != vmgrps.end() ; ++it)
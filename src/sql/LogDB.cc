@@ -22,6 +22,13 @@
 #include "RaftManager.h"
 #include "FedReplicaManager.h"
 #include "OneDB.h"
+#include "Metrics.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+#include <zlib.h>
 
 using namespace std;
 
@@ -106,9 +113,11 @@ int LogDBRecord::select_cb(void *nil, int num, char **values, char **names)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-LogDB::LogDB(SqlDB * _db, bool _solo, bool _cache, uint64_t _lret, uint64_t _lp):
+LogDB::LogDB(SqlDB * _db, bool _solo, bool _cache, uint64_t _lret, uint64_t _lp,
+             const std::string& _snapshot):
     solo(_solo), cache(_cache), db(_db), next_index(0), last_applied(-1),
-    last_index(-1), last_term(-1), log_retention(_lret), limit_purge(_lp)
+    last_index(-1), last_term(-1), log_retention(_lret), limit_purge(_lp),
+    snapshot_file(_snapshot)
 {
     uint64_t r, i;
 
@@ -185,7 +194,7 @@ int LogDB::setup_index(uint64_t& _last_applied, uint64_t& _last_index)
         last_term = lr.term;
     }
 
-    build_federated_index();
+    build_federated_index(false);
 
     return rc;
 }
@@ -525,7 +534,15 @@ int LogDB::_exec_wr(ostringstream& cmd, uint64_t federated)
         return -1;
     }
 
-    return replicate(rindex);
+    static auto& commit_time = Metrics::instance().histogram("one_raft_commit_seconds");
+
+    auto start = LatencyHistogram::clock::now();
+
+    rc = replicate(rindex);
+
+    commit_time.observe(start);
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -712,6 +729,13 @@ int LogDB::purge_log()
 
     cb.set_affected_rows(0);
 
+    // The snapshot would include the purged records if oned stops before
+    // the index is built again
+    if ( !snapshot_file.empty() )
+    {
+        unlink(snapshot_file.c_str());
+    }
+
     oss.str("");
     oss << "DELETE FROM logdb WHERE applied = '1' "
         << "AND fed_index != " << UINT64_MAX << " AND log_index < " << min_idx;
@@ -728,7 +752,7 @@ int LogDB::purge_log()
         rc += frc;
     }
 
-    build_federated_index();
+    build_federated_index(true);
 
     foss << frc << " records purged. Federated log size: " << fed_log.size()
          << ". Federation log state: " << fed_min << "," << fed_max << " - "
@@ -782,22 +806,212 @@ int LogDB::replicate(uint64_t rindex)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void LogDB::build_federated_index()
+void LogDB::build_federated_index(bool full)
 {
     std::ostringstream oss;
 
-    fed_log.clear();
+    set<uint64_t> tail;
 
     set_cb<uint64_t> cb;
 
-    cb.set_callback(&fed_log);
+    uint64_t sindex;
+
+    bool snapshot = !full && load_fed_snapshot(sindex) == 0;
+
+    if ( !snapshot )
+    {
+        fed_log.clear();
+    }
+
+    cb.set_callback(&tail);
 
     oss << "SELECT fed_index FROM " << one_db::log_table
         << " WHERE fed_index != " << UINT64_MAX;
 
+    if ( snapshot )
+    {
+        oss << " AND log_index > " << sindex;
+    }
+
+    int rc = db->exec_rd(oss, &cb);
+
+    cb.unset_callback();
+
+    fed_log.insert(tail.begin(), tail.end());
+
+    if ( snapshot )
+    {
+        oss.str("");
+
+        oss << "Federated index loaded from snapshot at record " << sindex
+            << ", " << tail.size() << " newer records read from DB";
+
+        NebulaLog::log("DBM", Log::DEBUG, oss);
+    }
+
+    if ( rc == 0 && !(snapshot && sindex == last_index) )
+    {
+        save_fed_snapshot();
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+const char LogDB::SNAPSHOT_MAGIC[8] = { 'O', 'N', 'E', 'L', 'O', 'G', 'D', 'B' };
+
+const uint32_t LogDB::SNAPSHOT_VERSION = 1;
+
+/* -------------------------------------------------------------------------- */
+
+template<typename T>
+static void snapshot_put(std::string& buf, T value)
+{
+    buf.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool snapshot_get(const std::string& buf, size_t& pos, T& value)
+{
+    if ( pos + sizeof(T) > buf.size() )
+    {
+        return false;
+    }
+
+    memcpy(&value, buf.data() + pos, sizeof(T));
+
+    pos += sizeof(T);
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int LogDB::load_fed_snapshot(uint64_t& index)
+{
+    if ( snapshot_file.empty() )
+    {
+        return -1;
+    }
+
+    std::ifstream file(snapshot_file, std::ios::binary);
+
+    if ( !file.good() )
+    {
+        return -1;
+    }
+
+    std::string buf((std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+
+    size_t   pos = sizeof(SNAPSHOT_MAGIC);
+    uint32_t version, term, crc;
+    uint64_t size;
+
+    if ( buf.size() < pos + sizeof(crc) ||
+         buf.compare(0, pos, SNAPSHOT_MAGIC, pos) != 0 )
+    {
+        NebulaLog::warn("DBM", "Wrong format of snapshot " + snapshot_file);
+        return -1;
+    }
+
+    size_t body = buf.size() - sizeof(crc);
+
+    memcpy(&crc, buf.data() + body, sizeof(crc));
+
+    if ( crc != crc32(0L, reinterpret_cast<const Bytef *>(buf.data()), body) )
+    {
+        NebulaLog::warn("DBM", "Wrong checksum of snapshot " + snapshot_file);
+        return -1;
+    }
+
+    if ( !snapshot_get(buf, pos, version) || version != SNAPSHOT_VERSION ||
+         !snapshot_get(buf, pos, index) || !snapshot_get(buf, pos, term) ||
+         !snapshot_get(buf, pos, size) || size != (body - pos) / sizeof(uint64_t) )
+    {
+        NebulaLog::warn("DBM", "Wrong version or size of snapshot " + snapshot_file);
+        return -1;
+    }
+
+    // The snapshot is valid if the log includes the same record
+    std::ostringstream oss;
+
+    single_cb<uint64_t> cb;
+
+    uint64_t log_term = UINT64_MAX;
+
+    cb.set_callback(&log_term);
+
+    oss << "SELECT term FROM " << one_db::log_table << " WHERE log_index = "
+        << index;
+
     db->exec_rd(oss, &cb);
 
     cb.unset_callback();
+
+    if ( log_term != term )
+    {
+        return -1;
+    }
+
+    fed_log.clear();
+
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        uint64_t fed_index;
+
+        snapshot_get(buf, pos, fed_index);
+
+        fed_log.insert(fed_log.end(), fed_index);
+    }
+
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LogDB::save_fed_snapshot()
+{
+    if ( snapshot_file.empty() || last_index == UINT64_MAX )
+    {
+        return;
+    }
+
+    std::string buf;
+
+    buf.reserve(sizeof(SNAPSHOT_MAGIC) + 32 + fed_log.size() * sizeof(uint64_t));
+
+    buf.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+
+    snapshot_put<uint32_t>(buf, SNAPSHOT_VERSION);
+    snapshot_put<uint64_t>(buf, last_index);
+    snapshot_put<uint32_t>(buf, last_term);
+    snapshot_put<uint64_t>(buf, fed_log.size());
+
+    for (auto fed_index : fed_log)
+    {
+        snapshot_put<uint64_t>(buf, fed_index);
+    }
+
+    uint32_t crc = crc32(0L, reinterpret_cast<const Bytef *>(buf.data()),
+                         buf.size());
+
+    snapshot_put<uint32_t>(buf, crc);
+
+    // Write a temporary file and rename it, to never leave a partial snapshot
+    std::string tmp_file = snapshot_file + ".tmp";
+
+    std::ofstream file(tmp_file, std::ios::binary | std::ios::trunc);
+
+    file.write(buf.data(), buf.size());
+
+    file.close();
+
+    if ( file.fail() || rename(tmp_file.c_str(), snapshot_file.c_str()) != 0 )
+    {
+        NebulaLog::warn("DBM", "Cannot write snapshot " + snapshot_file);
+
+        unlink(tmp_file.c_str());
+    }
 }
 
 /* -------------------------------------------------------------------------- */
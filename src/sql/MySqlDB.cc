@@ -396,10 +396,22 @@ int MySqlDB::exec_ext(std::ostringstream& cmd, Callbackable *obj, bool quiet)
 
     if (obj != 0)
     {
-        // Retrieve the entire result set all at once
-        MYSQL_RES * result = mysql_store_result(db);
+        bool stream = obj->isCallBackSet() && obj->is_streamed();
 
-        int num_rows = mysql_affected_rows(db);
+        MYSQL_RES * result;
+
+        if (stream)
+        {
+            // Rows are fetched from the server one at a time, as consumed
+            result = mysql_use_result(db);
+        }
+        else
+        {
+            // Retrieve the entire result set all at once
+            result = mysql_store_result(db);
+        }
+
+        int num_rows = stream ? 0 : mysql_affected_rows(db);
 
         if ( obj->isCallBackSet() )
         {
@@ -444,6 +456,19 @@ int MySqlDB::exec_ext(std::ostringstream& cmd, Callbackable *obj, bool quiet)
                 }
             }
 
+            // When streaming, errors while fetching rows are reported here
+            if ( stream && ec == SqlDB::SUCCESS && mysql_errno(db) != 0 )
+            {
+                ostringstream oss;
+
+                oss << "SQL command was: " << c_str;
+                oss << ", error " << mysql_errno(db) << " : " << mysql_error(db);
+
+                NebulaLog::log("ONE", error_level, oss);
+
+                ec = SqlDB::SQL;
+            }
+
             delete[] names;
         }
 
@@ -452,7 +477,7 @@ int MySqlDB::exec_ext(std::ostringstream& cmd, Callbackable *obj, bool quiet)
             obj->set_affected_rows(num_rows);
         }
 
-        // Free the result object
+        // Free the result object, discards any pending row of a streamed result
         mysql_free_result(result);
     }
 
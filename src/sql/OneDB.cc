@@ -206,6 +206,17 @@ namespace one_db
                                         "history (vid INTEGER, seq INTEGER, body MEDIUMTEXT, "
                                         "stime INTEGER, etime INTEGER,PRIMARY KEY(vid,seq))";
 
+    const char * history_acct_table = "history_acct";
+
+    const char * history_acct_db_names = "vid, seq, vm_uid, vm_gid, hid, cid, "
+                                         "stime, etime, rstime, retime, cpu, memory, disk";
+
+    const char * history_acct_db_bootstrap = "CREATE TABLE IF NOT EXISTS "
+                                             "history_acct (vid INTEGER, seq INTEGER, vm_uid INTEGER, "
+                                             "vm_gid INTEGER, hid INTEGER, cid INTEGER, stime INTEGER, "
+                                             "etime INTEGER, rstime INTEGER, retime INTEGER, cpu FLOAT, "
+                                             "memory BIGINT, disk BIGINT, PRIMARY KEY(vid,seq))";
+
     /* ---------------------------------------------------------------------- */
     /* Hook tables                                                            */
     /* ---------------------------------------------------------------------- */
@@ -16,6 +16,7 @@
 
 #include "SqlDB.h"
 #include "NebulaLog.h"
+#include "Metrics.h"
 
 #include <unistd.h>
 #include <csignal>
@@ -23,8 +24,22 @@
 
 int SqlDB::exec(std::ostringstream& cmd, Callbackable* obj, bool quiet)
 {
+    static auto& rd_time = Metrics::instance().histogram("one_db_seconds", "op=\"read\"");
+    static auto& wr_time = Metrics::instance().histogram("one_db_seconds", "op=\"write\"");
+
+    auto start = LatencyHistogram::clock::now();
+
     int rc = exec_ext(cmd, obj, quiet);
 
+    if ( obj != nullptr )
+    {
+        rd_time.observe(start);
+    }
+    else
+    {
+        wr_time.observe(start);
+    }
+
     if (rc != 0)
     {
         consecutive_errors++;
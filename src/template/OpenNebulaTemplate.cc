@@ -407,6 +407,8 @@ void OpenNebulaTemplate::set_conf_default()
     vvalue.insert(make_pair("SYSTEM", "file"));
     vvalue.insert(make_pair("DEBUG_LEVEL", "3"));
     vvalue.insert(make_pair("USE_VMS_LOCATION", "NO"));
+    vvalue.insert(make_pair("BUFFER_SIZE", "0"));
+    vvalue.insert(make_pair("OVERFLOW", "BLOCK"));
 
     vattribute = new VectorAttribute("LOG", vvalue);
     conf_default.insert(make_pair(vattribute->name(), vattribute));
@@ -421,6 +423,9 @@ void OpenNebulaTemplate::set_conf_default()
 
     set_conf_single("MAX_BACKUPS", "5");
     set_conf_single("MAX_BACKUPS_HOST", "2");
+    set_conf_single("MAX_BACKUPS_DS", "0");
+    set_conf_single("MAX_BACKUPS_DS_SIZE", "0");
+    set_conf_single("BACKUP_DS_RATE", "0");
 
     /*
     #*******************************************************************************
@@ -24,6 +24,9 @@
 #include "LifeCycleManager.h"
 #include "ImagePool.h"
 #include "PlanManager.h"
+#include "SSLUtil.h"
+
+#include <fstream>
 
 using namespace std;
 
@@ -32,6 +35,8 @@ using namespace std;
 
 const char * TransferManager::transfer_driver_name = "transfer_exe";
 
+const char * TransferManager::inline_prefix = "inline:";
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -333,7 +338,7 @@ void TransferManager::trigger_prolog(VirtualMachine * vm)
 
     trigger([this, vid]
     {
-        ofstream      xfr;
+        ostringstream xfr;
         ostringstream os("prolog, ");
         string        xfr_name;
 
@@ -382,12 +387,6 @@ void TransferManager::trigger_prolog(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".prolog";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         opennebula_hostname = nd.get_nebula_hostname();
 
@@ -452,7 +451,10 @@ void TransferManager::trigger_prolog(VirtualMachine * vm)
             }
         }
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -477,7 +479,6 @@ error_file:
         goto error_common;
 
 error_attributes:
-        xfr.close();
         goto error_common;
 
 error_common:
@@ -512,7 +513,7 @@ void TransferManager::trigger_prolog_migr(VirtualMachine * vm)
 
     trigger([this, vid]
     {
-        ofstream        xfr;
+        ostringstream   xfr;
         ostringstream   os;
         string          xfr_name;
 
@@ -551,12 +552,6 @@ void TransferManager::trigger_prolog_migr(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".migrate";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         // ------------------------------------------------------------------------
         // Move system directory and disks
@@ -614,7 +609,10 @@ void TransferManager::trigger_prolog_migr(VirtualMachine * vm)
             << vm->get_oid() << " "
             << vm->get_ds_id() << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -665,7 +663,7 @@ void TransferManager::trigger_prolog_resume(VirtualMachine * vm)
     }
     trigger([this, vid]
     {
-        ofstream        xfr;
+        ostringstream   xfr;
         ostringstream   os;
         string          xfr_name;
 
@@ -712,12 +710,6 @@ void TransferManager::trigger_prolog_resume(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".resume";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         // ------------------------------------------------------------------------
         // Move system directory and disks
@@ -768,7 +760,10 @@ void TransferManager::trigger_prolog_resume(VirtualMachine * vm)
             << vm->get_oid() << " "
             << vm->get_ds_id() << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -820,7 +815,7 @@ void TransferManager::trigger_prolog_attach(VirtualMachine * vm)
 
     trigger([this, vid]
     {
-        ofstream      xfr;
+        ostringstream xfr;
         ostringstream os("prolog, ");
         string        xfr_name;
 
@@ -861,12 +856,6 @@ void TransferManager::trigger_prolog_attach(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".prolog_attach";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         opennebula_hostname = nd.get_nebula_hostname();
 
@@ -892,7 +881,10 @@ void TransferManager::trigger_prolog_attach(VirtualMachine * vm)
             goto error_attributes;
         }
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -922,7 +914,6 @@ error_disk:
         goto error_common;
 
 error_attributes:
-        xfr.close();
         goto error_common;
 
 error_common:
@@ -1040,7 +1031,7 @@ void TransferManager::trigger_epilog(bool local, VirtualMachine * vm)
 
     trigger([this, local, vid]
     {
-        ofstream      xfr;
+        ostringstream xfr;
         ostringstream os;
 
         string xfr_name;
@@ -1078,12 +1069,6 @@ void TransferManager::trigger_epilog(bool local, VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".epilog";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         if (local)
         {
@@ -1109,7 +1094,10 @@ void TransferManager::trigger_epilog(bool local, VirtualMachine * vm)
             << vm->get_oid() << " "
             << vm->get_ds_id() << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1161,7 +1149,7 @@ void TransferManager::trigger_epilog_stop(VirtualMachine * vm)
 
     trigger([this, vid]
     {
-        ofstream      xfr;
+        ostringstream xfr;
         ostringstream os;
 
         string xfr_name;
@@ -1202,12 +1190,6 @@ void TransferManager::trigger_epilog_stop(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".stop";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         // ------------------------------------------------------------------------
         // Move system directory and disks
@@ -1262,7 +1244,10 @@ void TransferManager::trigger_epilog_stop(VirtualMachine * vm)
             << vm->get_oid() << " "
             << vm->get_ds_id() << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1451,7 +1436,7 @@ void TransferManager::trigger_epilog_delete(bool local, VirtualMachine * vm)
     {
         ostringstream os;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         Nebula&          nd = Nebula::instance();
@@ -1478,12 +1463,6 @@ void TransferManager::trigger_epilog_delete(bool local, VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".delete";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         rc = epilog_delete_commands(vm.get(), xfr, local, false);
 
@@ -1492,7 +1471,10 @@ void TransferManager::trigger_epilog_delete(bool local, VirtualMachine * vm)
             goto error_common;
         }
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1540,7 +1522,7 @@ void TransferManager::trigger_epilog_delete_previous(VirtualMachine * vm)
     {
         ostringstream os;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         Nebula&          nd = Nebula::instance();
@@ -1567,12 +1549,6 @@ void TransferManager::trigger_epilog_delete_previous(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".delete_prev";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         rc = epilog_delete_commands(vm.get(), xfr, false, true);
 
@@ -1581,7 +1557,10 @@ void TransferManager::trigger_epilog_delete_previous(VirtualMachine * vm)
             goto error_common;
         }
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1629,7 +1608,7 @@ void TransferManager::trigger_epilog_delete_both(VirtualMachine * vm)
     {
         ostringstream os;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         Nebula&          nd = Nebula::instance();
@@ -1656,12 +1635,6 @@ void TransferManager::trigger_epilog_delete_both(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".delete_both";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         rc = epilog_delete_commands(vm.get(), xfr, false, false); //current
         rc = epilog_delete_commands(vm.get(), xfr, false, true);  //previous
@@ -1671,7 +1644,10 @@ void TransferManager::trigger_epilog_delete_both(VirtualMachine * vm)
             goto error_common;
         }
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1717,7 +1693,7 @@ void TransferManager::trigger_epilog_detach(VirtualMachine * vm)
 
     trigger([this, vid]
     {
-        ofstream        xfr;
+        ostringstream   xfr;
         ostringstream   os;
         string xfr_name;
         string vm_tm_mad;
@@ -1753,12 +1729,6 @@ void TransferManager::trigger_epilog_detach(VirtualMachine * vm)
         }
 
         xfr_name = vm->get_transfer_file() + ".epilog_detach";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         // -------------------------------------------------------------------------
         // copy back VM image (DISK with SAVE="yes")
@@ -1773,7 +1743,10 @@ void TransferManager::trigger_epilog_detach(VirtualMachine * vm)
 
         epilog_transfer_command(vm.get(), vm->get_hostname(), disk, xfr);
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -1856,7 +1829,7 @@ void TransferManager::trigger_saveas_hot(int vid)
 
         ostringstream os;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         const Driver<transfer_msg_t> * tm_md;
@@ -1892,12 +1865,6 @@ void TransferManager::trigger_saveas_hot(int vid)
         }
 
         xfr_name = vm->get_transfer_file() + ".disk_saveas";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         disk = vm->get_disk(disk_id);
 
@@ -1931,7 +1898,10 @@ void TransferManager::trigger_saveas_hot(int vid)
             << ds_id
             << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -2038,7 +2008,7 @@ void TransferManager::do_snapshot_action(int vid, const char * snap_action)
 {
     ostringstream os;
 
-    ofstream xfr;
+    ostringstream xfr;
     string   xfr_name;
 
     unique_ptr<VirtualMachine> vm;
@@ -2066,22 +2036,19 @@ void TransferManager::do_snapshot_action(int vid, const char * snap_action)
     }
 
     xfr_name = vm->get_transfer_file() + ".disk_snapshot";
-    xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-    if (xfr.fail() == true)
-    {
-        goto error_file;
-    }
 
     rc = snapshot_transfer_command(vm.get(), snap_action, xfr);
 
-    xfr.close();
-
     if ( rc == -1 )
     {
         goto error_common;
     }
 
+    if ( transfer_payload(xfr_name, xfr) != 0 )
+    {
+        goto error_file;
+    }
+
     vm.reset();
 
     {
@@ -2195,7 +2162,7 @@ void TransferManager::trigger_resize(int vid)
     {
         ostringstream os;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         unique_ptr<VirtualMachine> vm;
@@ -2223,12 +2190,6 @@ void TransferManager::trigger_resize(int vid)
         }
 
         xfr_name = vm->get_transfer_file() + ".disk_resize";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         disk = vm->get_resize_disk();
 
@@ -2239,7 +2200,10 @@ void TransferManager::trigger_resize(int vid)
 
         resize_command(vm.get(), disk, xfr);
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         vm.reset();
 
@@ -2285,7 +2249,7 @@ void TransferManager::trigger_restore(int vid, int img_id, int inc_id,
     {
         ostringstream oss;
 
-        ofstream xfr;
+        ostringstream xfr;
         string   xfr_name;
 
         auto tm_md = get();
@@ -2312,12 +2276,6 @@ void TransferManager::trigger_restore(int vid, int img_id, int inc_id,
         }
 
         xfr_name = vm->get_transfer_file() + ".restore";
-        xfr.open(xfr_name.c_str(), ios::out | ios::trunc);
-
-        if (xfr.fail() == true)
-        {
-            goto error_file;
-        }
 
         //RESTORE tm_mad host:remote_dir vm_id img_id inc_id disk_id
         xfr << "RESTORE" << " "
@@ -2329,7 +2287,10 @@ void TransferManager::trigger_restore(int vid, int img_id, int inc_id,
             << disk_id << " "
             << endl;
 
-        xfr.close();
+        if ( transfer_payload(xfr_name, xfr) != 0 )
+        {
+            goto error_file;
+        }
 
         {
             transfer_msg_t msg(TransferManagerMessages::TRANSFER, "", vid, xfr_name);
@@ -2476,6 +2437,8 @@ int TransferManager::load_drivers(const std::vector<const VectorAttribute*>& _ma
 
     tm_conf.replace("NAME", transfer_driver_name);
 
+    tm_conf.vector_value("INLINE_SCRIPTS", inline_scripts);
+
     if ( load_driver(&tm_conf) != 0 )
     {
         NebulaLog::error("TrM", "Unable to load Transfer Manager driver");
@@ -2486,3 +2449,43 @@ int TransferManager::load_drivers(const std::vector<const VectorAttribute*>& _ma
 
     return 0;
 }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int TransferManager::transfer_payload(string& xfr_name, const ostringstream& xfr)
+{
+    string script = xfr.str();
+
+    if ( inline_scripts )
+    {
+        string zscript;
+
+        if ( ssl_util::zlib_compress64(script, zscript) == 0 )
+        {
+            if ( NebulaLog::log_level() >= Log::DDEBUG )
+            {
+                ofstream file(xfr_name, ios::out | ios::trunc);
+
+                file << script;
+            }
+
+            xfr_name = inline_prefix + zscript;
+
+            return 0;
+        }
+    }
+
+    ofstream file(xfr_name, ios::out | ios::trunc);
+
+    if (file.fail() == true)
+    {
+        return -1;
+    }
+
+    file << script;
+
+    file.close();
+
+    return file.fail() ? -1 : 0;
+}
@@ -37,6 +37,8 @@ require 'load_opennebula_paths'
 $LOAD_PATH << RUBY_LIB_LOCATION
 
 require 'shellwords'
+require 'base64'
+require 'zlib'
 require 'OpenNebulaDriver'
 require 'CommandManager'
 require 'getoptlong'
@@ -47,6 +49,9 @@ require 'getoptlong'
 # specific datastore to the hosts
 class TransferManagerDriver < OpenNebulaDriver
 
+    # Prefix of transfer scripts sent in the TRANSFER message
+    INLINE_PREFIX = 'inline:'
+
     # Register TRANSFER action, and tm drivers available
     # @param tm_type [Array] of tm types
     # @param options [Hash] basic options for an OpenNebula driver
@@ -73,9 +78,16 @@ class TransferManagerDriver < OpenNebulaDriver
     end
 
     # Driver Action: TRANSFER id script_file
-    # Executes a transfer script
+    # Executes a transfer script. The script can be a file or embedded in the
+    # message (inline:<zlib + base64 script>)
     def action_transfer(id, script_file)
-        script = parse_script(script_file)
+        if script_file.start_with?(INLINE_PREFIX)
+            zscript = script_file.delete_prefix(INLINE_PREFIX)
+            script  = parse_text(Zlib::Inflate.inflate(Base64.decode64(zscript)))
+            script_file = 'inline script'
+        else
+            script = parse_script(script_file)
+        end
 
         if script.nil?
             return send_message('TRANSFER', RESULT[:failure], id,
@@ -146,7 +158,13 @@ class TransferManagerDriver < OpenNebulaDriver
     def parse_script(sfile)
         return unless File.exist?(sfile)
 
-        stext = File.read(sfile)
+        parse_text(File.read(sfile))
+    end
+
+    # Parse the text of a transfer script
+    # @param stext [String] transfer script
+    # @return lines [Array] with the commands of the script
+    def parse_text(stext)
         lines = []
 
         stext.each_line do |line|
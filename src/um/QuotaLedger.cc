@@ -0,0 +1,268 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+
+#include "QuotaLedger.h"
+#include "Nebula.h"
+#include "UserPool.h"
+#include "GroupPool.h"
+
+using namespace std;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::start()
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    active = true;
+
+    entries.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::stop()
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    active = false;
+
+    entries.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool QuotaLedger::get(const char * table, int oid, string& xml)
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    if ( !active )
+    {
+        return false;
+    }
+
+    auto it = entries.find(make_pair(string(table), oid));
+
+    if ( it == entries.end() )
+    {
+        return false;
+    }
+
+    xml = it->second;
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::put(const char * table, int oid, const string& xml,
+                      bool replace)
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    if ( !active )
+    {
+        return;
+    }
+
+    auto key = make_pair(string(table), oid);
+
+    if ( replace )
+    {
+        entries[key] = xml;
+    }
+    else
+    {
+        entries.emplace(key, xml);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::erase(const char * table, int oid)
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    entries.erase(make_pair(string(table), oid));
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool QuotaLedger::check(Quotas& quota, Quotas::QuotaType type, Template * tmpl,
+                        int n, Quotas& default_quotas, string& error)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        if ( !quota.quota_check(type, tmpl, default_quotas, error) )
+        {
+            for (int j = 0; j < i; ++j)
+            {
+                quota.quota_del(type, tmpl);
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int QuotaLedger::reserve(int uid, int gid, Quotas::QuotaType type,
+                         Template * tmpl, int n, string& error)
+{
+    Nebula& nd = Nebula::instance();
+
+    UserPool *  upool = nd.get_upool();
+    GroupPool * gpool = nd.get_gpool();
+
+    bool do_user  = uid != UserPool::ONEADMIN_ID && uid != -1;
+    bool do_group = gid != GroupPool::ONEADMIN_ID && gid != -1;
+
+    auto user_rollback = [&]()
+    {
+        if ( auto user = upool->get(uid) )
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                user->quota.quota_del(type, tmpl);
+            }
+
+            upool->update_quotas(user.get());
+        }
+    };
+
+    if ( do_user )
+    {
+        auto user = upool->get(uid);
+
+        if ( !user )
+        {
+            error = "User not found";
+            return -1;
+        }
+
+        DefaultQuotas defaultq = nd.get_default_user_quota();
+
+        if ( !check(user->quota, type, tmpl, n, defaultq, error) )
+        {
+            error = "User [" + to_string(uid) + "] " + error;
+            return -1;
+        }
+
+        upool->update_quotas(user.get());
+    }
+
+    if ( do_group )
+    {
+        auto group = gpool->get(gid);
+
+        if ( !group )
+        {
+            error = "Group not found";
+
+            if ( do_user )
+            {
+                user_rollback();
+            }
+
+            return -1;
+        }
+
+        DefaultQuotas defaultq = nd.get_default_group_quota();
+
+        if ( !check(group->quota, type, tmpl, n, defaultq, error) )
+        {
+            error = "Group [" + to_string(gid) + "] " + error;
+
+            group.reset();
+
+            if ( do_user )
+            {
+                user_rollback();
+            }
+
+            return -1;
+        }
+
+        gpool->update_quotas(group.get());
+    }
+
+    lock_guard<mutex> lock(ledger_mutex);
+
+    int rid = next_rid++;
+
+    reservations.emplace(rid, Reservation{uid, gid, type,
+                                          make_unique<Template>(*tmpl), n});
+
+    return rid;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::commit(int rid, int n)
+{
+    lock_guard<mutex> lock(ledger_mutex);
+
+    auto it = reservations.find(rid);
+
+    if ( it == reservations.end() )
+    {
+        return;
+    }
+
+    it->second.count -= n;
+
+    if ( it->second.count <= 0 )
+    {
+        reservations.erase(it);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void QuotaLedger::rollback(int rid)
+{
+    Reservation r;
+
+    {
+        lock_guard<mutex> lock(ledger_mutex);
+
+        auto it = reservations.find(rid);
+
+        if ( it == reservations.end() )
+        {
+            return;
+        }
+
+        r = move(it->second);
+
+        reservations.erase(it);
+    }
+
+    int uid = r.uid == -1 ? UserPool::ONEADMIN_ID : r.uid;
+    int gid = r.gid == -1 ? GroupPool::ONEADMIN_ID : r.gid;
+
+    for (int i = 0; i < r.count; ++i)
+    {
+        Quotas::quota_del(r.type, uid, gid, r.tmpl.get());
+    }
+}
@@ -15,6 +15,7 @@
 /* -------------------------------------------------------------------------- */
 
 #include "QuotasSQL.h"
+#include "QuotaLedger.h"
 #include "Nebula.h"
 
 #include "ObjectXML.h"
@@ -61,6 +62,15 @@ int QuotasSQL::select(SqlDB * db)
     ostringstream   oss;
     int             rc;
 
+    QuotaLedger * ledger = Nebula::instance().get_quota_ledger();
+
+    string xml;
+
+    if ( ledger && ledger->get(table(), oid, xml) )
+    {
+        return from_xml(xml);
+    }
+
     set_callback(static_cast<Callbackable::Callback>(&QuotasSQL::select_cb));
 
     oss << "SELECT body FROM " << table()
@@ -75,6 +85,11 @@ int QuotasSQL::select(SqlDB * db)
         goto error_id;
     }
 
+    if ( ledger )
+    {
+        ledger->put(table(), oid, to_xml_db(xml), false);
+    }
+
     return 0;
 
 error_id:
@@ -160,11 +175,46 @@ error_common:
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+int QuotasSQL::update(SqlDB *db)
+{
+    QuotaLedger * ledger = Nebula::instance().get_quota_ledger();
+
+    string error_str;
+
+    int rc = insert_replace(db, true, error_str);
+
+    if ( ledger )
+    {
+        string xml;
+
+        if ( rc == 0 )
+        {
+            ledger->put(table(), oid, to_xml_db(xml), true);
+        }
+        else
+        {
+            ledger->erase(table(), oid);
+        }
+    }
+
+    return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 int QuotasSQL::drop(SqlDB *db)
 {
     ostringstream oss;
     int rc;
 
+    QuotaLedger * ledger = Nebula::instance().get_quota_ledger();
+
+    if ( ledger )
+    {
+        ledger->erase(table(), oid);
+    }
+
     oss << "DELETE FROM " << table()
         << " WHERE " << table_oid_column() << " = " << oid;
 
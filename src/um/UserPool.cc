@@ -24,6 +24,7 @@
 #include "AuthManager.h"
 #include "NebulaUtil.h"
 #include "Client.h"
+#include "Metrics.h"
 
 #include <fstream>
 #include <sys/types.h>
@@ -1307,6 +1308,10 @@ int UserPool::authorize(AuthRequest& ar)
     AuthManager * authm = nd.get_authm();
     int           rc    = -1;
 
+    static auto& authz_time = Metrics::instance().histogram("one_authorization_seconds");
+
+    auto start = LatencyHistogram::clock::now();
+
     if (authm == 0 || !authm->is_authz_enabled())
     {
         if (ar.core_authorize())
@@ -1332,6 +1337,8 @@ int UserPool::authorize(AuthRequest& ar)
         }
     }
 
+    authz_time.observe(start);
+
     return rc;
 }
 
@@ -194,12 +194,44 @@ int History::insert_replace(SqlDB *db, bool replace)
 
     db->free_str(sql_xml);
 
+    // Accounting rows are only written when the record is closed, so open
+    // records do not add a second replicated write on every update
+    if ( rc == 0 && etime != 0 )
+    {
+        rc = insert_replace_acct(db);
+    }
+
     return rc;
 
 error_body:
     return -1;
 }
 
+/* -------------------------------------------------------------------------- */
+
+int History::insert_replace_acct(SqlDB *db)
+{
+    ostringstream oss;
+
+    oss << "REPLACE INTO " << one_db::history_acct_table
+        << " (" << one_db::history_acct_db_names << ") VALUES ("
+        << oid           << ","
+        << seq           << ","
+        << vm_uid        << ","
+        << vm_gid        << ","
+        << hid           << ","
+        << cid           << ","
+        << stime         << ","
+        << etime         << ","
+        << running_stime << ","
+        << running_etime << ","
+        << cpu           << ","
+        << memory        << ","
+        << disk          << ")";
+
+    return db->exec_wr(oss);
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -260,7 +292,19 @@ int History::drop(SqlDB * db)
 
     oss << "DELETE FROM " << one_db::history_table << " WHERE vid= "<< oid;
 
-    return db->exec_wr(oss);
+    int rc = db->exec_wr(oss);
+
+    if ( rc == 0 )
+    {
+        oss.str("");
+
+        oss << "DELETE FROM " << one_db::history_acct_table << " WHERE vid= "
+            << oid;
+
+        rc = db->exec_wr(oss);
+    }
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -452,6 +496,19 @@ int History::rebuild_attributes()
         vm_info = oss.str();
 
         ObjectXML::free_nodes(content);
+
+        xpath(vm_uid, "/HISTORY/VM/UID", -1);
+        xpath(vm_gid, "/HISTORY/VM/GID", -1);
+
+        xpath<float>(cpu, "/HISTORY/VM/TEMPLATE/CPU", 0);
+        xpath<long long>(memory, "/HISTORY/VM/TEMPLATE/MEMORY", 0);
+
+        float disk_sz;
+
+        xpath<float>(disk_sz, "sum(/HISTORY/VM/TEMPLATE/DISK/SIZE | "
+                     "/HISTORY/VM/TEMPLATE/DISK/DISK_SNAPSHOT_TOTAL_SIZE)", 0);
+
+        disk = static_cast<long long>(disk_sz);
     }
 
     non_persistent_data();
@@ -637,6 +637,7 @@ int VirtualMachine::bootstrap(SqlDB * db)
 
     ostringstream oss_monit(one_db::vm_monitor_db_bootstrap);
     ostringstream oss_hist(one_db::history_db_bootstrap);
+    ostringstream oss_hist_acct(one_db::history_acct_db_bootstrap);
     ostringstream oss_showback(one_db::vm_showback_db_bootstrap);
 
     ostringstream oss_index("CREATE INDEX state_oid_idx on vm_pool (state, oid);");
@@ -646,6 +647,7 @@ int VirtualMachine::bootstrap(SqlDB * db)
 
     rc += db->exec_local_wr(oss_monit);
     rc += db->exec_local_wr(oss_hist);
+    rc += db->exec_local_wr(oss_hist_acct);
     rc += db->exec_local_wr(oss_showback);
 
     return rc;
@@ -1961,13 +1963,6 @@ int VirtualMachine::insert_replace(SqlDB *db, bool replace, string& error_str)
         goto error_xml_short;
     }
 
-    sql_text = db->escape_str(to_json(text));
-
-    if ( sql_text == 0 )
-    {
-        goto error_text;
-    }
-
     if (replace)
     {
         oss << "UPDATE " << one_db::vm_table << " SET "
@@ -1981,12 +1976,18 @@ int VirtualMachine::insert_replace(SqlDB *db, bool replace, string& error_str)
             << "owner_u = "       <<  owner_u       << ", "
             << "group_u = "       <<  group_u       << ", "
             << "other_u = "       <<  other_u       << ", "
-            << "short_body = '"   <<  sql_short_xml << "', "
-            << "body_json = '"    <<  sql_text      << "' "
+            << "short_body = '"   <<  sql_short_xml << "' "
             << "WHERE oid = "     <<  oid;
     }
     else
     {
+        sql_text = db->escape_str(to_json(text));
+
+        if ( sql_text == 0 )
+        {
+            goto error_text;
+        }
+
         oss << "INSERT INTO " << one_db::vm_table
             << " ("<< one_db::vm_db_names << ") VALUES ("
             <<        oid           << ","
@@ -2012,10 +2013,18 @@ int VirtualMachine::insert_replace(SqlDB *db, bool replace, string& error_str)
 
     rc = db->exec_wr(oss);
 
+    if ( replace && rc == 0 )
+    {
+        // The search information (body_json) is updated asynchronously
+        if ( auto vmpool = Nebula::instance().get_vmpool() )
+        {
+            vmpool->update_search_async(oid);
+        }
+    }
+
     return rc;
 
 error_text:
-    db->free_str(sql_text);
 error_xml_short:
     db->free_str(sql_short_xml);
 error_xml:
@@ -2092,6 +2101,8 @@ void VirtualMachine::add_history(
 
     history = make_unique<History>(oid, seq, hid, hostname, cid, vmm_mad, tm_mad,
                                    ds_id, -2, -1, vm_xml);
+
+    set_history_acct(history.get());
 };
 
 /* -------------------------------------------------------------------------- */
@@ -2120,6 +2131,8 @@ void VirtualMachine::cp_history()
                        history->action_id,
                        vm_xml);
 
+    set_history_acct(htmp.get());
+
     previous_history = move(history);
     history          = move(htmp);
 }
@@ -2150,6 +2163,8 @@ void VirtualMachine::cp_previous_history()
                        previous_history->action_id,
                        vm_xml);
 
+    set_history_acct(htmp.get());
+
     previous_history = move(history);
     history          = move(htmp);
 }
@@ -2157,6 +2172,33 @@ void VirtualMachine::cp_previous_history()
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+void VirtualMachine::set_history_acct(History * h)
+{
+    h->vm_uid = uid;
+    h->vm_gid = gid;
+
+    h->cpu    = 0;
+    h->memory = 0;
+    h->disk   = 0;
+
+    get_template_attribute("CPU", h->cpu);
+    get_template_attribute("MEMORY", h->memory);
+
+    for (const auto disk : disks)
+    {
+        long long size = 0;
+        long long snap = 0;
+
+        disk->vector_value("SIZE", size);
+        disk->vector_value("DISK_SNAPSHOT_TOTAL_SIZE", snap);
+
+        h->disk += size + snap;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 void VirtualMachine::get_capacity(HostShareCapacity& sr) const
 {
     sr.set(oid, *obj_template);
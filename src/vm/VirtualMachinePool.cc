@@ -23,12 +23,16 @@
 #include "ImageManager.h"
 #include "SchedulerManager.h"
 #include "HostPool.h"
+#include "RaftManager.h"
 
 #include <algorithm>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 
+const size_t VirtualMachinePool::search_batch = 1000;
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
@@ -52,6 +56,78 @@ VirtualMachinePool::VirtualMachinePool(
 
     // Set encrypted attributes
     VirtualMachineTemplate::parse_encrypted(encrypted_attrs);
+
+    search_timer.start(1, [this]() {search_indexer(search_batch);});
+}
+
+/* -------------------------------------------------------------------------- */
+
+VirtualMachinePool::~VirtualMachinePool()
+{
+    search_timer.stop();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void VirtualMachinePool::search_indexer(size_t max_vms)
+{
+    // Followers get body_json through log replication
+    RaftManager * raftm = Nebula::instance().get_raftm();
+
+    if (!raftm || (!raftm->is_leader() && !raftm->is_solo()))
+    {
+        return;
+    }
+
+    vector<int> oids;
+
+    {
+        lock_guard<mutex> lock(search_mutex);
+
+        auto it = search_pending.begin();
+
+        for (; it != search_pending.end() && oids.size() < max_vms; ++it)
+        {
+            oids.push_back(*it);
+        }
+
+        search_pending.erase(search_pending.begin(), it);
+    }
+
+    for (auto oid : oids)
+    {
+        if ( auto vm = get_ro(oid) )
+        {
+            vm->update_search(db);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualMachinePool::rebuild_search()
+{
+    vector<int> oids;
+
+    ostringstream where;
+
+    where << "state <> " << VirtualMachine::DONE;
+
+    search(oids, where.str());
+
+    lock_guard<mutex> lock(search_mutex);
+
+    search_pending.insert(oids.begin(), oids.end());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VirtualMachinePool::finalize_search()
+{
+    search_timer.stop();
+
+    search_indexer(SIZE_MAX);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -75,9 +151,53 @@ int VirtualMachinePool::update(PoolObjectSQL * objsql)
 
     vm->set_prev_state();
 
-    return vm->update(db);
+    int rc = vm->update(db);
+
+    if ( rc == 0 )
+    {
+        set_vm_state(vm);
+    }
+
+    return rc;
 };
 
+/* -------------------------------------------------------------------------- */
+
+void VirtualMachinePool::set_vm_state(VirtualMachine * vm, bool info)
+{
+    lock_guard<mutex> lock(states_mutex);
+
+    if ( vm->get_state() == VirtualMachine::DONE )
+    {
+        vm_states.erase(vm->get_oid());
+        return;
+    }
+
+    auto& vms = vm_states[vm->get_oid()];
+
+    vms.state     = vm->get_state();
+    vms.lcm_state = vm->get_lcm_state();
+    vms.deploy_id = vm->get_deploy_id();
+
+    if ( vm->hasHistory() )
+    {
+        vms.hid   = vm->get_hid();
+        vms.stime = vm->get_running_stime();
+        vms.etime = vm->get_running_etime();
+    }
+    else
+    {
+        vms.hid   = -1;
+        vms.stime = 0;
+        vms.etime = 0;
+    }
+
+    if ( info )
+    {
+        vms.info = time(nullptr);
+    }
+}
+
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -219,16 +339,8 @@ int VirtualMachinePool::get_cluster_vms(int user_id, int group_id, int cid,
     // Filter VM state
     os << "state != " << VirtualMachine::DONE << " AND ";
 
-    // Filter cluster
-    if (db->supports(SqlDB::SqlFeature::JSON_QUERY))
-    {
-        os << "JSON_CONTAINS(body_json, '\"" << cid
-           << "\"', '$.VM.HISTORY_RECORDS.HISTORY[0].CID')";
-    }
-    else
-    {
-        os << "short_body LIKE '%<CID>" << cid << "</CID>%'";
-    }
+    // Filter cluster, short_body is used as body_json is updated asynchronously
+    os << "short_body LIKE '%<CID>" << cid << "</CID>%'";
 
     return PoolSQL::search(oids, one_db::vm_table, os.str());
 }
@@ -265,43 +377,215 @@ int VirtualMachinePool::dump_acct(string& oss, const string&  where,
 
     cmd << " ORDER BY vid,seq";
 
-    return PoolSQL::dump(oss, "HISTORY_RECORDS", cmd);
+    return PoolSQL::dump(oss, "HISTORY_RECORDS", cmd, true);
 }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 int VirtualMachinePool::dump_acct(string& oss,
-                                  int time_start, int time_end, int sid, int rows)
+                                  int time_start, int time_end, int sid, int rows,
+                                  int part, int num_parts)
 {
     ostringstream cmd;
 
+    string next = " WHERE ";
+
     cmd << "SELECT " << "body FROM " << one_db::history_table;
 
-    if ( time_start != -1 || time_end != -1 )
+    if ( time_start != -1 )
     {
-        string next = " WHERE ";
+        cmd << next << "(etime > " << time_start << " OR  etime = 0)";
+        next = " AND ";
+    }
 
-        if ( time_start != -1 )
+    if ( time_end != -1 )
+    {
+        cmd << next << "stime < " << time_end;
+        next = " AND ";
+    }
+
+    if ( num_parts > 1 )
+    {
+        cmd << next << "vid % " << num_parts << " = " << part;
+    }
+
+    cmd << " ORDER BY vid,seq";
+
+    if (rows != -1)
+    {
+        cmd << " " << db->limit_string(sid, rows);
+    }
+
+    return PoolSQL::dump(oss, "HISTORY_RECORDS", cmd, rows == -1);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+/**
+ *  Callback to render the accounting totals, one TOTAL element per row:
+ *  id, vms, records, hours, rhours, cpu_hours, mem_hours, disk_hours
+ */
+class acct_totals_cb : public Callbackable
+{
+public:
+    void set_callback(std::string * _xml)
+    {
+        xml = _xml;
+
+        Callbackable::set_callback(
+                static_cast<Callbackable::Callback>(&acct_totals_cb::callback), 0);
+    };
+
+    int callback(void * nil, int num, char **values, char **names)
+    {
+        static const char * elems[] = {"ID", "VMS", "RECORDS", "HOURS",
+                                       "RHOURS", "CPU_HOURS", "MEMORY_HOURS",
+                                       "DISK_HOURS"
+                                      };
+
+        if ( num != 8 || values == 0 || values[0] == 0 )
         {
-            cmd << " WHERE (etime > " << time_start << " OR  etime = 0)";
-            next = " AND ";
+            return -1;
         }
 
-        if ( time_end != -1 )
+        ostringstream oss;
+
+        oss << "<TOTAL>";
+
+        for (int i = 0; i < num; ++i)
         {
-            cmd << next << "stime < " << time_end;
+            const char * value = values[i] != 0 ? values[i] : "0";
+
+            oss << "<" << elems[i] << ">";
+
+            if ( i < 3 )
+            {
+                oss << value;
+            }
+            else
+            {
+                oss << one_util::float_to_str(strtof(value, nullptr));
+            }
+
+            oss << "</" << elems[i] << ">";
         }
+
+        oss << "</TOTAL>";
+
+        xml->append(oss.str());
+
+        return 0;
+    };
+
+private:
+    std::string * xml;
+};
+
+/**
+ *  SQL expression with the seconds of the [st, et] interval (et = 0 for open
+ *  intervals) that overlap the [ws, we] window
+ */
+static string overlap_sql(const string& st, const string& et, time_t ws, time_t we)
+{
+    ostringstream oss;
+
+    oss << "(CASE WHEN " << st << " = 0 OR " << st << " >= " << we
+        << " OR (" << et << " <> 0 AND " << et << " <= " << ws << ") THEN 0 ELSE"
+        << " (CASE WHEN " << et << " = 0 OR " << et << " > " << we
+        << " THEN " << we << " ELSE " << et << " END) -"
+        << " (CASE WHEN " << st << " < " << ws << " THEN " << ws
+        << " ELSE " << st << " END) END)";
+
+    return oss.str();
+}
+
+int VirtualMachinePool::dump_acct_totals(string&       oss,
+                                         const string& where,
+                                         AcctGroupBy   group_by,
+                                         time_t        time_start,
+                                         time_t        time_end)
+{
+    ostringstream cmd;
+
+    string column;
+    string group_str;
+
+    switch (group_by)
+    {
+        case ACCT_USER:
+            column    = "vm_uid";
+            group_str = "USER";
+            break;
+
+        case ACCT_GROUP:
+            column    = "vm_gid";
+            group_str = "GROUP";
+            break;
+
+        case ACCT_HOST:
+            column    = "hid";
+            group_str = "HOST";
+            break;
+
+        case ACCT_CLUSTER:
+            column    = "cid";
+            group_str = "CLUSTER";
+            break;
+
+        default:
+            return -1;
     }
 
-    cmd << " ORDER BY vid,seq";
+    if ( time_start < 0 )
+    {
+        time_start = 0;
+    }
 
-    if (rows != -1)
+    if ( time_end < 0 )
     {
-        cmd << " " << db->limit_string(sid, rows);
+        time_end = time(nullptr);
     }
 
-    return PoolSQL::dump(oss, "HISTORY_RECORDS", cmd);
+    string hours  = overlap_sql("stime", "etime", time_start, time_end);
+    string rhours = overlap_sql("rstime", "retime", time_start, time_end);
+
+    cmd << "SELECT " << column << ", COUNT(DISTINCT vid), COUNT(*), "
+        << "SUM(" << hours << ") / 3600.0, "
+        << "SUM(" << rhours << ") / 3600.0, "
+        << "SUM(cpu * " << hours << ") / 3600.0, "
+        << "SUM(memory * " << hours << ") / 3600.0, "
+        << "SUM(disk * " << hours << ") / 3600.0"
+        << " FROM " << one_db::history_acct_table
+        << " INNER JOIN " << one_db::vm_table << " ON vid = oid"
+        << " WHERE stime <> 0 AND stime < " << time_end
+        << " AND etime > " << time_start;
+
+    if ( !where.empty() )
+    {
+        cmd << " AND (" << where << ")";
+    }
+
+    cmd << " GROUP BY " << column << " ORDER BY " << column;
+
+    acct_totals_cb cb;
+
+    oss.append("<ACCOUNTING_TOTALS>");
+
+    oss.append("<GROUP_BY>" + group_str + "</GROUP_BY>");
+    oss.append("<START_TIME>" + to_string(time_start) + "</START_TIME>");
+    oss.append("<END_TIME>" + to_string(time_end) + "</END_TIME>");
+
+    cb.set_callback(&oss);
+
+    int rc = db->exec_rd(cmd, &cb);
+
+    cb.unset_callback();
+
+    oss.append("</ACCOUNTING_TOTALS>");
+
+    return rc;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -343,7 +627,7 @@ int VirtualMachinePool::dump_showback(string& oss,
 
     cmd << " ORDER BY year,month,vmid";
 
-    return PoolSQL::dump(oss, "SHOWBACK_RECORDS", cmd);
+    return PoolSQL::dump(oss, "SHOWBACK_RECORDS", cmd, true);
 };
 
 /* -------------------------------------------------------------------------- */
@@ -418,7 +702,7 @@ int VirtualMachinePool::dump_monitoring(
             break;
     }
 
-    return PoolSQL::dump(oss, "MONITORING_DATA", cmd);
+    return PoolSQL::dump(oss, "MONITORING_DATA", cmd, true);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -529,6 +813,16 @@ struct VMCost
     map<time_t, SBRecord> totals;
 };
 
+/**
+ *  System attribute with the end time of the last complete showback run
+ */
+static const char * showback_watermark = "SHOWBACK_WATERMARK";
+
+/**
+ *  Max number of threads used to process the history records
+ */
+static const unsigned int showback_max_threads = 8;
+
 int VirtualMachinePool::calculate_showback(
         int start_month,
         int start_year,
@@ -536,7 +830,6 @@ int VirtualMachinePool::calculate_showback(
         int end_year,
         string &error_str)
 {
-    vector<xmlNodePtr> nodes;
     vector<time_t>     showback_slots;
     map<int, VMCost>   vm_costs;
 
@@ -549,15 +842,12 @@ int VirtualMachinePool::calculate_showback(
     string          sql_cmd_end;
 
     tm    tmp_tm;
-    int   vid;
-    time_t   h_stime, h_rstime;
-    time_t   h_etime, h_retime;
-    float cpu_cost;
-    float mem_cost;
-    float disk_cost;
-    float cpu;
-    float disk;
-    int   mem;
+
+    bool   incremental = false;
+    time_t watermark   = 0;
+    string watermark_xml;
+
+    Nebula& nd = Nebula::instance();
 
 #ifdef SBDEBUG
     ostringstream debug;
@@ -588,16 +878,45 @@ int VirtualMachinePool::calculate_showback(
     }
     else
     {
-        // Set start time to the lowest stime from the history records
-        single_cb<time_t> cb;
+        incremental = (end_month == -1 || end_year == -1);
+
+        // Runs without start and end dates start from the month of the last
+        // complete run, if any. Previous months are final as every record
+        // ending before it was processed.
+        if ( incremental &&
+             nd.select_sys_attribute(showback_watermark, watermark_xml) == 0 &&
+             !watermark_xml.empty() )
+        {
+            ObjectXML xml(watermark_xml);
+
+            xml.xpath(watermark, "/SHOWBACK_WATERMARK/END_TIME", (time_t)0);
+        }
+
+        if ( watermark > 0 )
+        {
+            localtime_r(&watermark, &tmp_tm);
+
+            tmp_tm.tm_sec  = 0;
+            tmp_tm.tm_min  = 0;
+            tmp_tm.tm_hour = 0;
+            tmp_tm.tm_mday = 1;
+            tmp_tm.tm_isdst = -1;
+
+            start_time = mktime(&tmp_tm);
+        }
+        else
+        {
+            // Set start time to the lowest stime from the history records
+            single_cb<time_t> cb;
 
-        cb.set_callback(&start_time);
+            cb.set_callback(&start_time);
 
-        oss << "SELECT MIN(stime) FROM " << one_db::history_table;
+            oss << "SELECT MIN(stime) FROM " << one_db::history_table;
 
-        rc = db->exec_rd(oss, &cb);
+            rc = db->exec_rd(oss, &cb);
 
-        cb.unset_callback();
+            cb.unset_callback();
+        }
     }
 
     if (end_month != -1 && end_year != -1)
@@ -665,131 +984,182 @@ int VirtualMachinePool::calculate_showback(
     auto debug_t_1 = std::chrono::high_resolution_clock::now();
 #endif
 
-    int start_index = 0;
-    const int chunk_size = 10000;
-
-    do
+    //--------------------------------------------------------------------------
+    // Process the history records. Records are partitioned by VM id, so each
+    // worker computes the costs of a disjoint set of VMs
+    //--------------------------------------------------------------------------
+    auto process_records = [&](int part, int num_parts, map<int, VMCost>& costs)
     {
-        //--------------------------------------------------------------------------
-        // Get accounting history records
-        //--------------------------------------------------------------------------
+        vector<xmlNodePtr> nodes;
+
+        int   vid;
+        time_t   h_stime, h_rstime;
+        time_t   h_etime, h_retime;
+        float cpu_cost;
+        float mem_cost;
+        float disk_cost;
+        float cpu;
+        float disk;
+        int   mem;
+
+#ifdef SBDDEBUG
+        ostringstream debug;
+#endif
 
-        std::string acct_str;
+        int start_index = 0;
+        const int chunk_size = 10000;
 
-        dump_acct(acct_str, start_time, end_time, start_index, chunk_size);
-        start_index += chunk_size;
+        do
+        {
+            //------------------------------------------------------------------
+            // Get accounting history records
+            //------------------------------------------------------------------
 
-        ObjectXML xml(acct_str);
+            std::string acct_str;
 
-        //--------------------------------------------------------------------------
-        // Process the history records
-        //--------------------------------------------------------------------------
+            dump_acct(acct_str, start_time, end_time, start_index, chunk_size,
+                      part, num_parts);
 
-        nodes.clear();
-        xml.get_nodes("/HISTORY_RECORDS/HISTORY", nodes);
+            start_index += chunk_size;
 
-        for ( auto node : nodes )
-        {
-            ObjectXML history(node);
+            ObjectXML xml(acct_str);
 
-            history.xpath(vid,      "/HISTORY/OID", -1);
+            nodes.clear();
+            xml.get_nodes("/HISTORY_RECORDS/HISTORY", nodes);
 
-            history.xpath(h_stime,  "/HISTORY/STIME", (time_t)0);
-            history.xpath(h_etime,  "/HISTORY/ETIME", (time_t)0);
+            for ( auto node : nodes )
+            {
+                ObjectXML history(node);
 
-            history.xpath(h_rstime,  "/HISTORY/RSTIME", (time_t)0);
-            history.xpath(h_retime,  "/HISTORY/RETIME", (time_t)0);
+                history.xpath(vid,      "/HISTORY/OID", -1);
 
-            history.xpath<float>(cpu,  "/HISTORY/VM/TEMPLATE/CPU", 0.0);
-            history.xpath(mem,  "/HISTORY/VM/TEMPLATE/MEMORY", 0);
-            history.xpath<float>(disk, "sum(/HISTORY/VM/TEMPLATE/DISK/SIZE | "
-                                 "/HISTORY/VM/TEMPLATE/DISK/DISK_SNAPSHOT_TOTAL_SIZE)", 0.0);
+                history.xpath(h_stime,  "/HISTORY/STIME", (time_t)0);
+                history.xpath(h_etime,  "/HISTORY/ETIME", (time_t)0);
 
-            history.xpath(cpu_cost, "/HISTORY/VM/TEMPLATE/CPU_COST", _default_cpu_cost);
-            history.xpath(mem_cost, "/HISTORY/VM/TEMPLATE/MEMORY_COST", _default_mem_cost);
-            history.xpath(disk_cost, "/HISTORY/VM/TEMPLATE/DISK_COST", _default_disk_cost);
+                history.xpath(h_rstime,  "/HISTORY/RSTIME", (time_t)0);
+                history.xpath(h_retime,  "/HISTORY/RETIME", (time_t)0);
 
-            auto& vm_cost = vm_costs[vid];
-            history.xpath(vm_cost.vmname, "/HISTORY/VM/NAME", "");
-            history.xpath(vm_cost.uid, "/HISTORY/VM/UID", -1);
-            history.xpath(vm_cost.uname, "/HISTORY/VM/UNAME", "");
-            history.xpath(vm_cost.gid, "/HISTORY/VM/GID", -1);
-            history.xpath(vm_cost.gname, "/HISTORY/VM/GNAME", "");
+                history.xpath<float>(cpu,  "/HISTORY/VM/TEMPLATE/CPU", 0.0);
+                history.xpath(mem,  "/HISTORY/VM/TEMPLATE/MEMORY", 0);
+                history.xpath<float>(disk, "sum(/HISTORY/VM/TEMPLATE/DISK/SIZE | "
+                                     "/HISTORY/VM/TEMPLATE/DISK/DISK_SNAPSHOT_TOTAL_SIZE)", 0.0);
 
-#ifdef SBDDEBUG
-            int seq;
-            history.xpath(seq, "/HISTORY/SEQ", -1);
+                history.xpath(cpu_cost, "/HISTORY/VM/TEMPLATE/CPU_COST", _default_cpu_cost);
+                history.xpath(mem_cost, "/HISTORY/VM/TEMPLATE/MEMORY_COST", _default_mem_cost);
+                history.xpath(disk_cost, "/HISTORY/VM/TEMPLATE/DISK_COST", _default_disk_cost);
 
-            debug.str("");
-            debug << "VM " << vid << " SEQ " << seq << endl
-                  << "h_stime   " << h_stime << endl
-                  << "h_etime   " << h_etime << endl
-                  << "cpu_cost  " << cpu_cost << endl
-                  << "mem_cost  " << mem_cost << endl
-                  << "disk_cost " << disk_cost << endl
-                  << "cpu       " << cpu << endl
-                  << "mem       " << mem << endl
-                  << "disk      " << disk;
+                auto& vm_cost = costs[vid];
+                history.xpath(vm_cost.vmname, "/HISTORY/VM/NAME", "");
+                history.xpath(vm_cost.uid, "/HISTORY/VM/UID", -1);
+                history.xpath(vm_cost.uname, "/HISTORY/VM/UNAME", "");
+                history.xpath(vm_cost.gid, "/HISTORY/VM/GID", -1);
+                history.xpath(vm_cost.gname, "/HISTORY/VM/GNAME", "");
 
-            NebulaLog::log("SHOWBACK", Log::DEBUG, debug);
+#ifdef SBDDEBUG
+                int seq;
+                history.xpath(seq, "/HISTORY/SEQ", -1);
+
+                debug.str("");
+                debug << "VM " << vid << " SEQ " << seq << endl
+                      << "h_stime   " << h_stime << endl
+                      << "h_etime   " << h_etime << endl
+                      << "cpu_cost  " << cpu_cost << endl
+                      << "mem_cost  " << mem_cost << endl
+                      << "disk_cost " << disk_cost << endl
+                      << "cpu       " << cpu << endl
+                      << "mem       " << mem << endl
+                      << "disk      " << disk;
+
+                NebulaLog::log("SHOWBACK", Log::DEBUG, debug);
 #endif
 
-            for ( auto slot_it = showback_slots.begin(); slot_it != showback_slots.end()-1; slot_it++ )
-            {
-                time_t t      = *slot_it;
-                time_t t_next = *(slot_it+1);
-
-                auto count_sb_record = [&](time_t st, time_t et, bool cpu_mem, bool disk_total, bool running_hours)
+                for ( auto slot_it = showback_slots.begin(); slot_it != showback_slots.end()-1; slot_it++ )
                 {
-                    if( (et > t || et == 0) &&
-                        (st != 0 && st <= t_next) )
-                    {
+                    time_t t      = *slot_it;
+                    time_t t_next = *(slot_it+1);
 
-                        time_t stime = max(t, st);
-
-                        time_t etime = t_next;
-                        if(et != 0)
+                    auto count_sb_record = [&](time_t st, time_t et, bool cpu_mem, bool disk_total, bool running_hours)
+                    {
+                        if( (et > t || et == 0) &&
+                            (st != 0 && st <= t_next) )
                         {
-                            etime = min(t_next, et);
-                        }
-
-                        float n_hours = difftime(etime, stime) / 60 / 60;
 
-                        // Add to vm time slot.
-                        SBRecord& totals = vm_cost.totals[t];
-
-                        if (cpu_mem)
-                        {
-                            totals.cpu_cost += cpu_cost * cpu * n_hours;
-                            totals.mem_cost += mem_cost * mem * n_hours;
-                        }
-                        if (disk_total)
-                        {
-                            totals.disk_cost+= disk_cost* disk* n_hours;
-                            totals.hours    += n_hours;
+                            time_t stime = max(t, st);
+
+                            time_t etime = t_next;
+                            if(et != 0)
+                            {
+                                etime = min(t_next, et);
+                            }
+
+                            float n_hours = difftime(etime, stime) / 60 / 60;
+
+                            // Add to vm time slot.
+                            SBRecord& totals = vm_cost.totals[t];
+
+                            if (cpu_mem)
+                            {
+                                totals.cpu_cost += cpu_cost * cpu * n_hours;
+                                totals.mem_cost += mem_cost * mem * n_hours;
+                            }
+                            if (disk_total)
+                            {
+                                totals.disk_cost+= disk_cost* disk* n_hours;
+                                totals.hours    += n_hours;
+                            }
+                            if (running_hours)
+                            {
+                                totals.rhours   += n_hours;
+                            }
                         }
-                        if (running_hours)
-                        {
-                            totals.rhours   += n_hours;
-                        }
-                    }
-                };
+                    };
 
-                if (_showback_only_running)
-                {
-                    count_sb_record(h_stime, h_etime, false, true, false);
-                    count_sb_record(h_rstime, h_retime, true, false, true);
-                }
-                else
-                {
-                    count_sb_record(h_stime, h_etime, true, true, false);
-                    count_sb_record(h_rstime, h_retime, false, false, true);
+                    if (_showback_only_running)
+                    {
+                        count_sb_record(h_stime, h_etime, false, true, false);
+                        count_sb_record(h_rstime, h_retime, true, false, true);
+                    }
+                    else
+                    {
+                        count_sb_record(h_stime, h_etime, true, true, false);
+                        count_sb_record(h_rstime, h_retime, false, false, true);
+                    }
                 }
             }
+
+            xml.free_nodes(nodes);
+        } while (!nodes.empty());
+    };
+
+    unsigned int num_parts = std::thread::hardware_concurrency();
+
+    num_parts = std::max(1U, std::min(num_parts, showback_max_threads));
+
+    if ( num_parts == 1 )
+    {
+        process_records(0, 1, vm_costs);
+    }
+    else
+    {
+        vector<map<int, VMCost>> part_costs(num_parts);
+        vector<std::thread>      workers;
+
+        for (unsigned int i = 0; i < num_parts; ++i)
+        {
+            workers.emplace_back(process_records, i, num_parts,
+                                 std::ref(part_costs[i]));
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.join();
         }
 
-        xml.free_nodes(nodes);
-    } while (!nodes.empty());
+        for (auto& costs : part_costs)
+        {
+            vm_costs.merge(costs);
+        }
+    }
 
 #ifdef SBDEBUG
     auto debug_t_2 = std::chrono::high_resolution_clock::now();
@@ -928,6 +1298,32 @@ int VirtualMachinePool::calculate_showback(
         }
     }
 
+    //--------------------------------------------------------------------------
+    // Move the watermark, next run will only process months from end_time
+    //--------------------------------------------------------------------------
+    if ( incremental )
+    {
+        oss.str("");
+
+        oss << "<SHOWBACK_WATERMARK><END_TIME>" << end_time
+            << "</END_TIME></SHOWBACK_WATERMARK>";
+
+        if ( watermark_xml.empty() )
+        {
+            rc = nd.insert_sys_attribute(showback_watermark, oss.str(), error_str);
+        }
+        else
+        {
+            rc = nd.update_sys_attribute(showback_watermark, oss.str(), error_str);
+        }
+
+        if (rc != 0)
+        {
+            NebulaLog::log("SHOWBACK", Log::WARNING,
+                           "Could not update showback watermark: " + error_str);
+        }
+    }
+
 #ifdef SBDEBUG
     auto debug_t_3 = std::chrono::high_resolution_clock::now();
 
@@ -205,17 +205,36 @@ void VMGroupRole::host_requirements(std::set<int>& hosts, const std::string& op1
 
 /* -------------------------------------------------------------------------- */
 
-void VMGroupRole::affined_host_requirements(std::string& reqs)
+void VMGroupRole::affined_hosts(std::set<int>& hosts) const
 {
-    std::ostringstream oss;
-    std::set<int> hosts;
-
     string shosts = va->vector_value("HOST_AFFINED");
 
     if ( !shosts.empty() )
     {
         one_util::split_unique(shosts, ',', hosts);
     }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VMGroupRole::antiaffined_hosts(std::set<int>& hosts) const
+{
+    string shosts = va->vector_value("HOST_ANTI_AFFINED");
+
+    if ( !shosts.empty() )
+    {
+        one_util::split_unique(shosts, ',', hosts);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void VMGroupRole::affined_host_requirements(std::string& reqs)
+{
+    std::ostringstream oss;
+    std::set<int> hosts;
+
+    affined_hosts(hosts);
 
     host_requirements(hosts, "=", "|", oss);
 
@@ -229,12 +248,7 @@ void VMGroupRole::antiaffined_host_requirements(std::string& reqs)
     std::ostringstream oss;
     std::set<int> hosts;
 
-    string shosts = va->vector_value("HOST_ANTI_AFFINED");
-
-    if ( !shosts.empty() )
-    {
-        one_util::split_unique(shosts, ',', hosts);
-    }
+    antiaffined_hosts(hosts);
 
     host_requirements(hosts, "!=", "&", oss);
 
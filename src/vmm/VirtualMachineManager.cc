@@ -2366,23 +2366,38 @@ error_common:
 
 int VirtualMachineManager::updatesg(VirtualMachine * vm, int sgid)
 {
-    string   vm_tmpl;
-    string   drv_msg;
+    string drv_msg;
 
-    if (!vm->hasHistory())
+    if ( updatesg_data(vm, sgid, drv_msg) != 0 )
     {
         return -1;
     }
 
-    // Get the driver for this VM
+    // Invoke driver method
     const VirtualMachineManagerDriver * vmd = get(vm->get_vmm_mad());
 
-    if ( vmd == nullptr )
+    vmd->updatesg(vm->get_oid(), drv_msg);
+
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int VirtualMachineManager::updatesg_data(VirtualMachine * vm, int sgid,
+                                         string& drv_msg)
+{
+    string   vm_tmpl;
+
+    if (!vm->hasHistory())
+    {
+        return -1;
+    }
+
+    if ( get(vm->get_vmm_mad()) == nullptr )
     {
         return -1;
     }
 
-    // Invoke driver method
     drv_msg = format_message(
                       vm->get_hostname(),
                       "",
@@ -2397,7 +2412,50 @@ int VirtualMachineManager::updatesg(VirtualMachine * vm, int sgid)
                       vm->get_ds_id(),
                       sgid);
 
-    vmd->updatesg(vm->get_oid(), drv_msg);
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int VirtualMachineManager::updatesg(const string& vmm_mad, int sgid,
+                                    const vector<pair<int, string>>& vms)
+{
+    const VirtualMachineManagerDriver * vmd = get(vmm_mad);
+
+    if ( vmd == nullptr || vms.empty() )
+    {
+        return -1;
+    }
+
+    if ( vms.size() == 1 )
+    {
+        vmd->updatesg(vms[0].first, vms[0].second);
+
+        return 0;
+    }
+
+    // Batch message, it includes the driver data of each VM. It is sent with
+    // the ID of the first VM, the driver replies for each VM in the batch
+    ostringstream oss;
+
+    oss << "<VMM_DRIVER_ACTION_BATCH>"
+        << "<SECURITY_GROUP_ID>" << sgid << "</SECURITY_GROUP_ID>";
+
+    for (const auto& vm : vms)
+    {
+        oss << "<VM>"
+            << "<ID>"   << vm.first  << "</ID>"
+            << "<DATA>" << vm.second << "</DATA>"
+            << "</VM>";
+    }
+
+    oss << "</VMM_DRIVER_ACTION_BATCH>";
+
+    string base64;
+
+    ssl_util::base64_encode(oss.str(), base64);
+
+    vmd->updatesg(vms[0].first, base64);
 
     return 0;
 }
@@ -188,6 +188,14 @@ class DummyDriver < VirtualMachineDriver
         xml_data = decode(drv_message)
         sg_id    = xml_data.elements['SECURITY_GROUP_ID'].text
 
+        if xml_data.name == 'VMM_DRIVER_ACTION_BATCH'
+            xml_data.elements.each('VM') do |vm|
+                send_message(ACTION[:update_sg],result,vm.elements['ID'].text,sg_id)
+            end
+
+            return
+        end
+
         send_message(ACTION[:update_sg],result,id,sg_id)
     end
 
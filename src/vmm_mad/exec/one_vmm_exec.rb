@@ -1295,6 +1295,22 @@ class ExecDriver < VirtualMachineDriver
         xml_data = decode(drv_message)
         sg_id    = xml_data.elements['SECURITY_GROUP_ID'].text
 
+        # Batch of VMs in the same host, the action is run for each VM
+        if xml_data.name == 'VMM_DRIVER_ACTION_BATCH'
+            xml_data.elements.each('VM') do |vm|
+                vm_id = vm.elements['ID'].text
+
+                begin
+                    update_sg(vm_id, vm.elements['DATA'].text)
+                rescue StandardError => e
+                    send_message(ACTION[:update_sg], RESULT[:failure], vm_id,
+                                 "#{sg_id} #{e.message}")
+                end
+            end
+
+            return
+        end
+
         action = VmmAction.new(self, id, :update_sg, drv_message)
 
         steps = [
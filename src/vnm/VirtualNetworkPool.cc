@@ -56,16 +56,14 @@ VirtualNetworkPool::VirtualNetworkPool(
         const VectorAttribute *             _vlan_conf,
         const VectorAttribute *             _vxlan_conf):
     PoolSQL(db, one_db::vn_table), vlan_conf(_vlan_conf),
-    vxlan_conf(_vxlan_conf)
+    vxlan_conf(_vxlan_conf), vlan_bitmap(vlan_conf, VLAN_BITMAP_ID, vlan_table),
+    mac_bitmap(MAC_BITMAP_ID, vlan_table)
 {
     istringstream iss;
     size_t        pos   = 0;
     int           count = 0;
     unsigned int  tmp;
 
-    BitMap<4096> vlan_id_bitmap(vlan_conf, VLAN_BITMAP_ID, vlan_table);
-    BitMap<AddressRange::MAC_GLOBAL_SIZE> mac_global_bitmap(MAC_BITMAP_ID, vlan_table);
-
     string mac = prefix;
 
     _mac_prefix       = 0;
@@ -73,14 +71,14 @@ VirtualNetworkPool::VirtualNetworkPool(
 
     _default_size = __default_size;
 
-    if ( vlan_id_bitmap.select(VLAN_BITMAP_ID, db) != 0 )
+    if ( vlan_bitmap.select(VLAN_BITMAP_ID, db) != 0 )
     {
-        vlan_id_bitmap.insert(VLAN_BITMAP_ID, db);
+        vlan_bitmap.insert(VLAN_BITMAP_ID, db);
     }
 
-    if ( mac_global_bitmap.select(MAC_BITMAP_ID, db) != 0 )
+    if ( mac_bitmap.select(MAC_BITMAP_ID, db) != 0 )
     {
-        mac_global_bitmap.insert(MAC_BITMAP_ID, db);
+        mac_bitmap.insert(MAC_BITMAP_ID, db);
     }
 
     while ( (pos = mac.find(':')) !=  string::npos )
@@ -425,22 +423,22 @@ int VirtualNetworkPool::set_8021Q_id(int vnid, string& vlan_var, bool& auto_var)
     unsigned int vlan_id;
     ostringstream oss;
 
-    BitMap<4096> bitmap(vlan_conf, VLAN_BITMAP_ID, vlan_table);
+    lock_guard<mutex> lock(bitmap_mutex);
 
-    if ( bitmap.select(VLAN_BITMAP_ID, db) != 0 )
+    if ( vlan_bitmap.select(VLAN_BITMAP_ID, db) != 0 )
     {
         return -1;
     }
 
-    unsigned int start_vlan = bitmap.get_start_bit();
+    unsigned int start_vlan = vlan_bitmap.get_start_bit();
     unsigned int hint_vlan  = start_vlan + (vnid % (4095 - start_vlan));
 
-    if ( bitmap.get(hint_vlan, vlan_id) != 0 )
+    if ( vlan_bitmap.get(hint_vlan, vlan_id) != 0 )
     {
         return -1;
     }
 
-    bitmap.update(db);
+    vlan_bitmap.update(db);
 
     oss << vlan_id;
 
@@ -553,7 +551,9 @@ int VirtualNetworkPool::allocate_mac_id(unsigned int preferred_id, unsigned int&
         return 0;
     }
 
-    BitMap<AddressRange::MAC_GLOBAL_SIZE> bitmap(MAC_BITMAP_ID, vlan_table);
+    lock_guard<mutex> lock(vnpool->bitmap_mutex);
+
+    auto& bitmap = vnpool->mac_bitmap;
 
     if ( bitmap.select(MAC_BITMAP_ID, vnpool->db) != 0 )
     {
@@ -582,7 +582,9 @@ void VirtualNetworkPool::release_mac_id(int id)
         return;
     }
 
-    BitMap<AddressRange::MAC_GLOBAL_SIZE> bitmap(MAC_BITMAP_ID, vlan_table);
+    lock_guard<mutex> lock(vnpool->bitmap_mutex);
+
+    auto& bitmap = vnpool->mac_bitmap;
 
     if ( bitmap.select(MAC_BITMAP_ID, vnpool->db) != 0 )
     {
@@ -602,7 +604,9 @@ int VirtualNetworkPool::reserve_mac_id(unsigned int id)
         return 0;
     }
 
-    BitMap<AddressRange::MAC_GLOBAL_SIZE> bitmap(MAC_BITMAP_ID, vlan_table);
+    lock_guard<mutex> lock(vnpool->bitmap_mutex);
+
+    auto& bitmap = vnpool->mac_bitmap;
 
     if ( bitmap.select(MAC_BITMAP_ID, vnpool->db) != 0 )
     {
@@ -644,20 +648,20 @@ void VirtualNetworkPool::release_vlan_id(VirtualNetwork *vn)
     is.str(vn->vlan_id);
     is >> vlan_id;
 
-    BitMap<4096> bitmap(vlan_conf, VLAN_BITMAP_ID, vlan_table);
+    lock_guard<mutex> lock(bitmap_mutex);
 
     switch (VirtualNetwork::str_to_driver(vn->vn_mad))
     {
         case VirtualNetwork::VLAN:
         case VirtualNetwork::OVSWITCH:
         case VirtualNetwork::OVSWITCH_VXLAN:
-            if ( bitmap.select(VLAN_BITMAP_ID, db) != 0 )
+            if ( vlan_bitmap.select(VLAN_BITMAP_ID, db) != 0 )
             {
                 return;
             }
 
-            bitmap.reset(vlan_id);
-            bitmap.update(db);
+            vlan_bitmap.reset(vlan_id);
+            vlan_bitmap.update(db);
             break;
 
         case VirtualNetwork::NONE:
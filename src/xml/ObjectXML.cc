@@ -16,6 +16,7 @@
 
 #include <ObjectXML.h>
 #include <stdexcept>
+#include <cctype>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -103,6 +104,25 @@ void ObjectXML::xpaths(std::vector<std::string>& content, const char * expr)
     xmlNodePtr    cur;
     xmlChar *     str_ptr;
 
+    vector<xmlNodePtr> nodes;
+
+    if (path_nodes(expr, nodes))
+    {
+        for (auto node : nodes)
+        {
+            str_ptr = xmlNodeGetContent(node);
+
+            if (str_ptr != 0)
+            {
+                content.push_back(reinterpret_cast<char *>(str_ptr));
+
+                xmlFree(str_ptr);
+            }
+        }
+
+        return;
+    }
+
     obj = xmlXPathEvalExpression(reinterpret_cast<const xmlChar *>(expr), ctx);
 
     if (obj == 0)
@@ -219,6 +239,18 @@ int ObjectXML::get_nodes(const string& xpath_expr,
 {
     xmlXPathObjectPtr obj;
 
+    vector<xmlNodePtr> nodes;
+
+    if (path_nodes(xpath_expr.c_str(), nodes))
+    {
+        for (auto node : nodes)
+        {
+            content.push_back(xmlCopyNode(node, 1));
+        }
+
+        return nodes.size();
+    }
+
     obj = xmlXPathEvalExpression(
                   reinterpret_cast<const xmlChar *>(xpath_expr.c_str()), ctx);
 
@@ -262,6 +294,13 @@ int ObjectXML::get_nodes(const string& xpath_expr,
 
 int ObjectXML::count_nodes(const string& xpath_expr) const
 {
+    vector<xmlNodePtr> nodes;
+
+    if (path_nodes(xpath_expr.c_str(), nodes))
+    {
+        return nodes.size();
+    }
+
     xmlXPathObjectPtr obj = xmlXPathEvalExpression(
                                     reinterpret_cast<const xmlChar *>(xpath_expr.c_str()), ctx);
 
@@ -454,6 +493,94 @@ void ObjectXML::xml_parse(const string &xml_doc)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+bool ObjectXML::path_nodes(const char * expr, vector<xmlNodePtr>& nodes) const
+{
+    if ( expr == 0 || expr[0] != '/' || xml == 0 )
+    {
+        return false;
+    }
+
+    // Split the path in element names, only names are supported (no axes,
+    // predicates, wildcards or functions)
+    vector<pair<const char *, size_t>> names;
+
+    const char * name = expr + 1;
+    const char * cur  = name;
+
+    while (true)
+    {
+        if ( *cur == '/' || *cur == '\0' )
+        {
+            if ( cur == name )
+            {
+                return false;
+            }
+
+            names.emplace_back(name, cur - name);
+
+            if ( *cur == '\0' )
+            {
+                break;
+            }
+
+            name = ++cur;
+        }
+        else if ( isalpha(static_cast<unsigned char>(*cur)) || *cur == '_' ||
+                  (cur != name && (isdigit(static_cast<unsigned char>(*cur)) || *cur == '-' || *cur == '.')) )
+        {
+            ++cur;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    auto match = [&names](xmlNodePtr node, size_t i)
+    {
+        const char * nname = reinterpret_cast<const char *>(node->name);
+
+        return node->type == XML_ELEMENT_NODE && node->ns == 0 &&
+               strncmp(nname, names[i].first, names[i].second) == 0 &&
+               nname[names[i].second] == '\0';
+    };
+
+    xmlNodePtr root = xmlDocGetRootElement(xml);
+
+    if ( root == 0 || !match(root, 0) )
+    {
+        return true;
+    }
+
+    vector<xmlNodePtr> level = { root };
+    vector<xmlNodePtr> next;
+
+    for (size_t i = 1; i < names.size() && !level.empty(); ++i)
+    {
+        next.clear();
+
+        for (auto node : level)
+        {
+            for (xmlNodePtr child = node->children; child != 0; child = child->next)
+            {
+                if ( match(child, i) )
+                {
+                    next.push_back(child);
+                }
+            }
+        }
+
+        level.swap(next);
+    }
+
+    nodes.insert(nodes.end(), level.begin(), level.end());
+
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 int ObjectXML::rename_nodes(const char * xpath_expr, const char * new_name)
 {
     xmlXPathObjectPtr obj;
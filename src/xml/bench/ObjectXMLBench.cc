@@ -0,0 +1,190 @@
+/* -------------------------------------------------------------------------- */
+/* Copyright 2002-2026, OpenNebula Project, OpenNebula Systems                */
+/*                                                                            */
+/* Licensed under the Apache License, Version 2.0 (the "License"); you may    */
+/* not use this file except in compliance with the License. You may obtain    */
+/* a copy of the License at                                                   */
+/*                                                                            */
+/* http://www.apache.org/licenses/LICENSE-2.0                                 */
+/*                                                                            */
+/* Unless required by applicable law or agreed to in writing, software        */
+/* distributed under the License is distributed on an "AS IS" BASIS,          */
+/* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   */
+/* See the License for the specific language governing permissions and        */
+/* limitations under the License.                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ *  Loads a set of synthetic VM bodies with the same lookups done by
+ *  VirtualMachine::from_xml (3 disks, 2 NICs, context and one history record)
+ *  and prints the time spent. Built with "scons bench=yes":
+ *
+ *    ./src/xml/objectxml_bench [number of VMs, default 100000]
+ */
+
+#include "ObjectXML.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+static string vm_xml(int id)
+{
+    ostringstream oss;
+
+    oss << "<VM><ID>" << id << "</ID><UID>0</UID><GID>0</GID>"
+        << "<UNAME>oneadmin</UNAME><GNAME>oneadmin</GNAME>"
+        << "<NAME>vm-" << id << "</NAME>"
+        << "<PERMISSIONS>"
+        << "<OWNER_U>1</OWNER_U><OWNER_M>1</OWNER_M><OWNER_A>0</OWNER_A>"
+        << "<GROUP_U>0</GROUP_U><GROUP_M>0</GROUP_M><GROUP_A>0</GROUP_A>"
+        << "<OTHER_U>0</OTHER_U><OTHER_M>0</OTHER_M><OTHER_A>0</OTHER_A>"
+        << "</PERMISSIONS>"
+        << "<LAST_POLL>0</LAST_POLL><STATE>3</STATE><LCM_STATE>3</LCM_STATE>"
+        << "<PREV_STATE>3</PREV_STATE><PREV_LCM_STATE>3</PREV_LCM_STATE>"
+        << "<RESCHED>0</RESCHED><STIME>1700000000</STIME><ETIME>0</ETIME>"
+        << "<DEPLOY_ID>one-" << id << "</DEPLOY_ID>"
+        << "<LOCK><LOCKED>1</LOCKED><OWNER>0</OWNER><TIME>0</TIME>"
+        << "<REQ_ID>-1</REQ_ID></LOCK>"
+        << "<TEMPLATE><CPU><![CDATA[1]]></CPU>"
+        << "<MEMORY><![CDATA[1024]]></MEMORY><VCPU>2</VCPU>";
+
+    for (int i = 0; i < 3; i++)
+    {
+        oss << "<DISK><DISK_ID>" << i << "</DISK_ID>"
+            << "<IMAGE_ID>" << i << "</IMAGE_ID>"
+            << "<DATASTORE>default</DATASTORE><DATASTORE_ID>1</DATASTORE_ID>"
+            << "<SIZE>10240</SIZE>"
+            << "<SOURCE><![CDATA[/var/lib/one/datastores/1/" << i << "]]></SOURCE>"
+            << "<TARGET>vd" << static_cast<char>('a' + i) << "</TARGET>"
+            << "<TM_MAD>ssh</TM_MAD><TYPE>FILE</TYPE></DISK>";
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        oss << "<NIC><NIC_ID>" << i << "</NIC_ID>"
+            << "<NETWORK>net</NETWORK><NETWORK_ID>0</NETWORK_ID>"
+            << "<IP>10.0.0." << i << "</IP>"
+            << "<MAC>02:00:0a:00:00:0" << i << "</MAC>"
+            << "<BRIDGE>br0</BRIDGE><SECURITY_GROUPS>0</SECURITY_GROUPS></NIC>";
+    }
+
+    oss << "<CONTEXT><NETWORK>YES</NETWORK>"
+        << "<SSH_PUBLIC_KEY>ssh-rsa AAAA</SSH_PUBLIC_KEY><TARGET>hda</TARGET>"
+        << "</CONTEXT>"
+        << "<GRAPHICS><LISTEN>0.0.0.0</LISTEN><TYPE>VNC</TYPE></GRAPHICS>"
+        << "<OS><ARCH>x86_64</ARCH></OS></TEMPLATE>"
+        << "<USER_TEMPLATE><DESCRIPTION>test</DESCRIPTION></USER_TEMPLATE>"
+        << "<HISTORY_RECORDS><HISTORY><OID>" << id << "</OID><SEQ>0</SEQ>"
+        << "<HOSTNAME>host01</HOSTNAME></HISTORY></HISTORY_RECORDS>"
+        << "<BACKUPS><BACKUP_CONFIG/><BACKUP_IDS/></BACKUPS></VM>";
+
+    return oss.str();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+static long load_vm(const string& body)
+{
+    static const vector<string> int_paths = {
+        "/VM/UID", "/VM/GID", "/VM/RESCHED",
+        "/VM/PERMISSIONS/OWNER_U", "/VM/PERMISSIONS/OWNER_M",
+        "/VM/PERMISSIONS/OWNER_A", "/VM/PERMISSIONS/GROUP_U",
+        "/VM/PERMISSIONS/GROUP_M", "/VM/PERMISSIONS/GROUP_A",
+        "/VM/PERMISSIONS/OTHER_U", "/VM/PERMISSIONS/OTHER_M",
+        "/VM/PERMISSIONS/OTHER_A",
+        "/VM/STATE", "/VM/LCM_STATE", "/VM/PREV_STATE", "/VM/PREV_LCM_STATE",
+        "/VM/LOCK/LOCKED", "/VM/LOCK/OWNER", "/VM/LOCK/TIME", "/VM/LOCK/REQ_ID"
+    };
+
+    static const vector<string> str_paths = {
+        "/VM/UNAME", "/VM/GNAME", "/VM/NAME", "/VM/DEPLOY_ID"
+    };
+
+    static const vector<string> node_paths = {
+        "/VM/TEMPLATE", "/VM/USER_TEMPLATE", "/VM/SNAPSHOTS", "/VM/BACKUPS"
+    };
+
+    ObjectXML xml(body);
+
+    long   sum = 0;
+    int    ival;
+    time_t tval;
+    string sval;
+
+    vector<xmlNodePtr> nodes;
+
+    xml.xpath(ival, "/VM/ID", -1);
+    sum += ival;
+
+    for (const auto& path : int_paths)
+    {
+        xml.xpath(ival, path.c_str(), 0);
+    }
+
+    for (const auto& path : str_paths)
+    {
+        xml.xpath(sval, path.c_str(), "not_found");
+    }
+
+    xml.xpath<time_t>(tval, "/VM/STIME", 0);
+    xml.xpath<time_t>(tval, "/VM/ETIME", 0);
+
+    for (const auto& path : node_paths)
+    {
+        sum += xml.get_nodes(path, nodes);
+
+        xml.free_nodes(nodes);
+    }
+
+    xml.xpath(ival, "/VM/HISTORY_RECORDS/HISTORY/SEQ", -1);
+    sum += ival;
+
+    return sum;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char ** argv)
+{
+    int num_vms = 100000;
+
+    if (argc > 1)
+    {
+        num_vms = std::stoi(argv[1]);
+    }
+
+    vector<string> bodies;
+
+    bodies.reserve(num_vms);
+
+    for (int i = 0; i < num_vms; i++)
+    {
+        bodies.push_back(vm_xml(i));
+    }
+
+    long sum = 0;
+
+    auto start = chrono::steady_clock::now();
+
+    for (const auto& body : bodies)
+    {
+        sum += load_vm(body);
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << num_vms << " VMs loaded in " << elapsed.count() << "s"
+         << " (checksum " << sum << ")" << endl;
+
+    return 0;
+}